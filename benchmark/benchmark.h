@@ -2,18 +2,29 @@
 #define I_BMRK_7K45G66H7JI
 
 #include <map>
+#include <array>
 #include <memory>
 #include <vector>
 #include <string>
 #include <chrono>
+#include <cstdint>
 #include <cstddef>
 #include <utility>
 #include <fstream>
 #include <numeric>
 #include <iostream>
 #include <algorithm>
+#include <stdexcept>
 #include <type_traits>
 
+// build settings captured at configure time, see CMakeLists.txt
+#ifndef BMK_BUILD_TYPE_STRING
+#define BMK_BUILD_TYPE_STRING ""
+#endif
+#ifndef BMK_CXX_FLAGS_STRING
+#define BMK_CXX_FLAGS_STRING ""
+#endif
+
 namespace bmk
 {
 
@@ -22,6 +33,7 @@ namespace bmk
 	using std::vector; 
 	using std::string;
 	using std::size_t; 
+	using std::uint64_t; 
 	using std::ostream; 
 	using std::is_same; 
 	using std::forward; 
@@ -70,6 +82,259 @@ namespace bmk
 	template<          > string time_type<std::chrono::minutes     >() { return "minutes";      }
 	template<          > string time_type<std::chrono::hours       >() { return "hours";        }
 
+	/**
+	* @ class run_context
+	* @ brief machine, compiler and build settings a result file was produced with
+	*/
+	struct run_context
+	{
+		string cpu_model;
+		string cpu_count;
+		string caches;
+		string governor;
+		string turbo;
+		string kernel;
+		string compiler;
+		string build_type;
+		string flags;
+		bool   cpu_scaling = false;
+
+		/// collect the context from /proc, sysfs and the configure time settings
+		static run_context capture()
+		{
+			run_context ctx;
+
+			ctx.cpu_model  = cpuinfo("model name");
+			ctx.kernel     = read_line("/proc/sys/kernel/osrelease");
+			ctx.compiler   = compiler_id();
+			ctx.build_type = configured(BMK_BUILD_TYPE_STRING);
+			ctx.flags      = configured(BMK_CXX_FLAGS_STRING);
+
+			// online CPUs need not be numbered without gaps (offline or unplugged CPUs)
+			string const cpu = "/sys/devices/system/cpu/cpu";
+			auto online = cpu_list(read_line("/sys/devices/system/cpu/online"));
+			for (auto n : online)
+			{
+				auto governor = read_line(
+					cpu + std::to_string(n) + "/cpufreq/scaling_governor");
+				if (governor.empty()) continue;
+				if (ctx.governor.empty()) ctx.governor = governor;
+				if (governor != "performance") ctx.cpu_scaling = true;
+			}
+			ctx.cpu_count = online.empty() ? "unknown" : std::to_string(online.size());
+			if (ctx.governor.empty()) ctx.governor = "unknown";
+
+			string token{ "" };
+			auto first = cpu + std::to_string(online.empty() ? 0 : online.front());
+			for (size_t i = 0;; ++i)
+			{
+				auto index = first + "/cache/index" + std::to_string(i) + "/";
+				auto size  = read_line(index + "size");
+				if (size.empty()) break;
+
+				auto type = read_line(index + "type");
+				ctx.caches += token + "L" + read_line(index + "level")
+					+ (type == "Data" ? "d" : type == "Instruction" ? "i" : "") + " " + size;
+				token = ", ";
+			}
+
+			auto no_turbo = read_line("/sys/devices/system/cpu/intel_pstate/no_turbo");
+			auto boost    = read_line("/sys/devices/system/cpu/cpufreq/boost");
+			ctx.turbo = no_turbo == "1" || boost == "0" ? "off"
+				: no_turbo == "0" || boost == "1" ? "on" : "unknown";
+
+			return ctx;
+		}
+
+		/// print as a single 'context' dictionary line
+		void print(ostream& os) const
+		{
+			os << "{ 'context' : { "
+				<< "'cpu_model' : '"  << quoted(cpu_model)  << "', "
+				<< "'cpu_count' : '"  << quoted(cpu_count)  << "', "
+				<< "'caches' : '"     << quoted(caches)     << "', "
+				<< "'governor' : '"   << quoted(governor)   << "', "
+				<< "'turbo' : '"      << quoted(turbo)      << "', "
+				<< "'cpu_scaling' : " << (cpu_scaling ? "True" : "False") << ", "
+				<< "'kernel' : '"     << quoted(kernel)     << "', "
+				<< "'compiler' : '"   << quoted(compiler)   << "', "
+				<< "'build_type' : '" << quoted(build_type) << "', "
+				<< "'flags' : '"      << quoted(flags)      << "' } } \n";
+		}
+
+	private:
+		/// the CPU numbers of a sysfs list such as "0-3,6,8-9"
+		static vector<size_t> cpu_list(string const& list)
+		{
+			vector<size_t> cpus;
+			size_t pos = 0;
+			while (pos < list.size())
+			{
+				auto end = list.find(',', pos);
+				if (end == string::npos) end = list.size();
+				auto item = list.substr(pos, end - pos);
+				auto dash = item.find('-');
+				try
+				{
+					size_t first = std::stoul(item), last = dash == string::npos ? first : std::stoul(item.substr(dash + 1));
+					for (auto n = first; n <= last; ++n) cpus.push_back(n);
+				}
+				catch (std::exception const&) { return {}; }
+				pos = end + 1;
+			}
+			return cpus;
+		}
+
+		static string read_line(string const& path)
+		{
+			std::ifstream is(path);
+			string line;
+			std::getline(is, line);
+			return line;
+		}
+
+		static string cpuinfo(string const& key)
+		{
+			std::ifstream is("/proc/cpuinfo");
+			string line;
+			while (std::getline(is, line))
+			{
+				auto colon = line.find(':');
+				if (line.compare(0, key.size(), key) == 0 && colon != string::npos)
+				{
+					auto first = line.find_first_not_of(" \t", colon + 1);
+					return first == string::npos ? "" : line.substr(first);
+				}
+			}
+			return "unknown";
+		}
+
+		static string compiler_id()
+		{
+#if defined(BMK_CXX_COMPILER_STRING)
+			return BMK_CXX_COMPILER_STRING;
+#elif defined(__clang__)
+			return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+			return "GNU " __VERSION__;
+#elif defined(_MSC_VER)
+			return "MSVC " + std::to_string(_MSC_FULL_VER);
+#else
+			return "unknown";
+#endif
+		}
+
+		static string configured(const char* value)
+		{
+			return *value ? value : "unknown";
+		}
+
+		/// escape for python string literals
+		static string quoted(string const& s)
+		{
+			string result;
+			for (auto c : s)
+			{
+				if (c == '\\' || c == '\'') result += '\\';
+				result += c;
+			}
+			return result;
+		}
+	};
+
+	/**
+	* @ class histogram
+	* @ brief log-linear (HDR style) histogram of 64 bit values
+	*
+	* Values below 2^(SubBucketBits+1) are counted exactly, larger values in 
+	* 2^SubBucketBits sub-buckets per power of two, i.e. with a relative 
+	* resolution of 2^-SubBucketBits. Memory is fixed, record() never allocates.
+	*/
+	template<size_t SubBucketBits = 7>
+	class histogram
+	{
+		static constexpr size_t _subBuckets = size_t(1) << SubBucketBits;
+		static constexpr size_t _size       = (65 - SubBucketBits) * _subBuckets;
+
+		std::array<uint64_t, _size> _counts{}; 
+		uint64_t _total{ 0 };
+		uint64_t _max{ 0 };
+
+		static size_t msb(uint64_t value)
+		{
+#if defined(__GNUC__)
+			return 63 - __builtin_clzll(value);
+#else
+			size_t bit = 0;
+			while (value >>= 1) ++bit;
+			return bit;
+#endif
+		}
+
+	public:
+		/// bucket index of a value
+		static size_t index(uint64_t value)
+		{
+			if (value < 2 * _subBuckets) return size_t(value);
+			auto shift = msb(value) - SubBucketBits;
+			return shift * _subBuckets + size_t(value >> shift);
+		}
+
+		/// smallest value counted in bucket i
+		static uint64_t lowest(size_t i)
+		{
+			if (i < 2 * _subBuckets) return i;
+			auto shift = i / _subBuckets - 1;
+			return uint64_t(i - shift * _subBuckets) << shift;
+		}
+
+		/// largest value counted in bucket i
+		static uint64_t highest(size_t i)
+		{
+			if (i < 2 * _subBuckets) return i;
+			auto shift = i / _subBuckets - 1;
+			return ((uint64_t(i - shift * _subBuckets) + 1) << shift) - 1;
+		}
+
+		void record(uint64_t value)
+		{
+			++_counts[index(value)];
+			++_total;
+			if (value > _max) _max = value;
+		}
+
+		uint64_t count() const { return _total; }
+		uint64_t max()   const { return _max;   }
+
+		/// highest value not exceeded by the given fraction (0...1) of recorded values
+		uint64_t percentile(double fraction) const
+		{
+			if (_total == 0) return 0;
+
+			auto rank = uint64_t(fraction * _total + 0.5);
+			if (rank < 1) rank = 1;
+			if (rank >= _total) return _max;
+
+			uint64_t seen = 0;
+			for (size_t i = 0; i < _size; ++i)
+			{
+				seen += _counts[i];
+				if (seen >= rank) return std::min(highest(i), _max);
+			}
+			return _max;
+		}
+
+		/// call f(lowest, highest, count) for each non-empty bucket
+		template<class F>
+		void for_each_bucket(F f) const
+		{
+			for (size_t i = 0; i < _size; ++i)
+			{
+				if (_counts[i]) f(lowest(i), highest(i), _counts[i]);
+			}
+		}
+	};
+
 	template<class TimeT=std::chrono::milliseconds, class ClockT=std::chrono::steady_clock>
 	class timeout
 	{
@@ -291,6 +556,47 @@ namespace bmk
 			}
 
 		};
+		/**
+		* @ class experiment_latency
+		* @ brief per invocation latencies recorded into a histogram
+		*/
+		template<class TimeT, class ClockT>
+		struct experiment_latency final
+			: experiment
+		{
+			histogram<> _histogram;
+
+			template<class F>
+			experiment_latency(size_t nInvocation, F callable)
+			{
+				for (size_t i = 0; i < nInvocation; i++)
+				{
+					auto start = ClockT::now();
+					callable();
+					auto stop  = ClockT::now();
+					_histogram.record(uint64_t(duration_cast<TimeT>(stop - start).count()));
+				}
+			}
+
+			// forwarded functions --------------------------------------
+			void print(ostream& os) const override
+			{
+				os << ", 'latency' : { 'count' : " << _histogram.count()
+					<< ", 'p50' : "   << _histogram.percentile(0.5)
+					<< ", 'p99' : "   << _histogram.percentile(0.99)
+					<< ", 'p99.9' : " << _histogram.percentile(0.999)
+					<< ", 'max' : "   << _histogram.max() << " }";
+
+				string token{ "" };
+				os << ", 'histogram' : [ ";
+				_histogram.for_each_bucket([&](uint64_t low, uint64_t high, uint64_t count)
+				{
+					os << token << "[ " << low << ", " << high << ", " << count << " ]";
+					token = ", ";
+				});
+				os << " ]";
+			}
+		};
 	} // ~ namespace detail
 
 	/**
@@ -336,6 +642,14 @@ namespace bmk
 				nSample, callable, factorName, beg, fin));
 		}
 
+		/// record the latency of each of nInvocation calls into a histogram
+		template<class F>
+		void run_latency(string const& name, size_t nInvocation, F callable)
+		{
+			_data.emplace_back(name, make_unique<
+				detail::experiment_latency<TimeT, ClockT>>(nInvocation, callable));
+		}
+
 		// utilities ----------------------------------------------------
 		void print(const char* benchmarkName, ostream& os) const
 		{
@@ -353,8 +667,17 @@ namespace bmk
 			const char* benchmarkName, const char *filename,
 			std::ios_base::openmode mode = ofstream::out) const
 		{
+			auto context = run_context::capture();
+			if (context.cpu_scaling)
+			{
+				std::cerr << "***WARNING*** CPU scaling is enabled (governor '"
+					<< context.governor << "'), timings of '"
+					<< benchmarkName << "' may be noisy\n";
+			}
+
 			ofstream os;
 			os.open(filename, mode);
+			context.print(os);
 			for (auto&& Pair : _data)
 			{
 				os << "{ 'benchmark_name' : '" << benchmarkName << "'";
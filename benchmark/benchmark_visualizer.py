@@ -101,14 +101,45 @@ def plot_factored_bmks(factored):
     plt.show()
 # -----------------------------------------------------------------------            
 
+# -----------------------------------------------------------------------            
+def plot_latency_bmks(latencies):
+    """ Each latency histogram as cumulative distribution curve
+    """
+    plt.clf()
+    plt.title(latencies[0]['benchmark_name'])
+    for bmk in latencies:
+        highs  = [b[1] for b in bmk['histogram']]
+        counts = np.cumsum([b[2] for b in bmk['histogram']])
+        lat = bmk['latency']
+        plt.semilogx(highs, counts / float(lat['count']), drawstyle='steps-post',
+            label='%s (p50 %d, p99 %d, p99.9 %d, max %d)' % (bmk['experiment_name'],
+            lat['p50'], lat['p99'], lat['p99.9'], lat['max']))
+    plt.xlabel(latencies[0]['time_type'])
+    plt.ylabel('fraction of invocations')
+    plt.legend(loc='lower right', shadow=True)
+    plt.show()
+# -----------------------------------------------------------------------            
+
 # -----------------------------------------------------------------------            
 def plot_benchmark_dicts(bmk_dict_list):
     """ Plot the list of benchmark dictionaries
     """
-    factored = [x for x in bmk_dict_list if 'factors' in x]
-    simples  = [x for x in bmk_dict_list if 'factors' not in x]
+    latencies = [x for x in bmk_dict_list if 'latency' in x]
+    factored  = [x for x in bmk_dict_list if 'factors' in x]
+    simples   = [x for x in bmk_dict_list if 'factors' not in x and 'latency' not in x]
     if len(factored): plot_factored_bmks(factored)
     if len(simples): plot_simple_bmks(simples)
+    if len(latencies): plot_latency_bmks(latencies)
+# -----------------------------------------------------------------------            
+
+# -----------------------------------------------------------------------            
+def print_context(ctx):
+    """ Show machine and build settings the results were produced with
+    """
+    for key in sorted(ctx):
+        print('%-12s: %s' % (key, ctx[key]))
+    if ctx.get('cpu_scaling'):
+        print('WARNING: CPU scaling was enabled, timings may be noisy')
 # -----------------------------------------------------------------------            
 
 # -----------------------------------------------------------------------            
@@ -118,7 +149,9 @@ def plot_benchmark_file(filename):
     with open(filename) as f:
         content   = f.readlines() # every line is a dictionary
         all_dicts = [ast.literal_eval(line) for line in content]
-        plot_benchmark_dicts(all_dicts)
+        for ctx in [x['context'] for x in all_dicts if 'context' in x]:
+            print_context(ctx)
+        plot_benchmark_dicts([x for x in all_dicts if 'context' not in x])
 # -----------------------------------------------------------------------            
 
 # -----------------------------------------------------------------------            
@@ -1,5 +1,11 @@
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
 #include <iostream>
 #include "../loop.h"
+#include "../numeric.h"
+#include "../cursor.h"
 #include "benchmark.h"
 
 bool demo(int steps)
@@ -121,6 +127,485 @@ void benchmark_linspace()
 		<< sum5 << '\n';
 }
 
+void benchmark_interpolation()
+{	
+	double a = 1, b = 6;
+	double sum1, sum2, sum3, sum4, sum5;
+
+	auto sum_of = [&](int n, auto mode) 
+		{  
+			double sum = 0;
+			for (auto x : loop::linspace(a, b, n, loop::boundary::closed, mode))
+			{
+				sum += x;
+			}
+			return sum;
+		};
+
+	auto linear      = [&](int n) { sum1 = sum_of(n, loop::interpolation::linear()); };
+	auto fma         = [&](int n) { sum2 = sum_of(n, loop::interpolation::fma()); };
+	auto two_sided   = [&](int n) { sum3 = sum_of(n, loop::interpolation::two_sided()); };
+	auto incremental = [&](int n) { sum4 = sum_of(n, loop::interpolation::incremental()); };
+	auto reanchored  = [&](int n) { sum5 = sum_of(n, loop::interpolation::reanchored<>()); };
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("linear",      10, linear,      "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("fma",         10, fma,         "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("two_sided",   10, two_sided,   "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("incremental", 10, incremental, "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("reanchored",  10, reanchored,  "steps", { 10, 100, 1000, 10000, 100000 }); 
+
+    bm.serialize("linspace() interpolation modes", "interpolation.results.txt");
+
+	// accuracy: distance of the last value from b
+	auto last_of = [&](int n, auto mode) 
+		{  
+			double last = a;
+			for (auto x : loop::linspace(a, b, n, loop::boundary::closed, mode)) last = x;
+			return last - b;
+		};
+
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << ' ' 
+		<< sum3 << ' ' 
+		<< sum4 << ' ' 
+		<< sum5 << '\n'
+		<< "x_n - b for n = 100000: "
+		<< last_of(100000, loop::interpolation::linear()) << ' '
+		<< last_of(100000, loop::interpolation::fma()) << ' '
+		<< last_of(100000, loop::interpolation::two_sided()) << ' '
+		<< last_of(100000, loop::interpolation::incremental()) << ' '
+		<< last_of(100000, loop::interpolation::reanchored<>()) << '\n';
+}
+
+void benchmark_ilinspace()
+{	
+	int a = 0, b = 4095;
+	long long sum1, sum2;
+
+	auto rounded = [&](int n) 
+		{  
+			long long sum = 0;
+			for (auto x : loop::linspace(double(a), double(b), n))
+			{
+				sum += int(x + 0.5);
+			}
+			sum1 = sum;
+		};
+
+	auto ilinspace = [&](int n) 
+		{  
+			long long sum = 0;
+			for (auto x : loop::ilinspace(a, b, n))
+			{
+				sum += x;
+			}
+			sum2 = sum;
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("int(linspace()+0.5)", 10, rounded,   "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("ilinspace()",         10, ilinspace, "steps", { 10, 100, 1000, 10000, 100000 }); 
+
+    bm.serialize("rounded integer values", "ilinspace.results.txt");
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << '\n';
+}
+
+void benchmark_logspace()
+{	
+	double a = 1, b = 6;
+	std::vector<double> v(100001);
+	double sum1, sum2, sum3, sum4;
+
+	auto pow_linspace = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto x : loop::linspace(a, b, n))
+			{
+				sum += std::pow(10., x);
+			}
+			sum1 = sum;
+		};
+
+	auto logspace = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto x : loop::logspace(a, b, n))
+			{
+				sum += x;
+			}
+			sum2 = sum;
+		};
+
+	auto copy_pow = [&](int n) 
+		{  
+			auto p = v.data();
+			for (auto x : loop::linspace(a, b, n)) *p++ = std::pow(10., x);
+			sum3 = v[n / 2];
+		};
+
+	auto copy_logspace = [&](int n) 
+		{  
+			loop::copy(loop::logspace(a, b, n), v.data());
+			sum4 = v[n / 2];
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("pow(10, linspace())",  10, pow_linspace,  "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("logspace()",           10, logspace,      "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("store pow(10, x)",     10, copy_pow,      "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("copy(logspace())",     10, copy_logspace, "steps", { 10, 100, 1000, 10000, 100000 }); 
+
+    bm.serialize("log spaced values", "logspace.results.txt");
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << ' ' 
+		<< sum3 << ' ' 
+		<< sum4 << '\n';
+}
+
+void benchmark_trigonometric()
+{	
+	const double pi = std::acos(-1.);
+	double sum1, sum2, sum3, sum4;
+
+	auto libm = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto t : loop::linspace(0., 2 * pi, n))
+			{
+				sum += std::cos(t) * std::sin(t);
+			}
+			sum1 = sum;
+		};
+
+	auto cis = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto z : loop::cis(0., 2 * pi, n))
+			{
+				sum += z.real() * z.imag();
+			}
+			sum2 = sum;
+		};
+
+	auto cos_nodes = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto k : loop::range(n + 1))
+			{
+				sum += std::cos(k * pi / n);
+			}
+			sum3 = sum;
+		};
+
+	auto chebyshev = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto x : loop::chebyshev2(n))
+			{
+				sum += x;
+			}
+			sum4 = sum;
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("cos, sin(linspace())", 10, libm,      "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("cis()",                10, cis,       "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("cos(k*pi/n)",          10, cos_nodes, "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("chebyshev2()",         10, chebyshev, "steps", { 10, 100, 1000, 10000, 100000 }); 
+
+    bm.serialize("trigonometric values", "trigonometric.results.txt");
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << ' ' 
+		<< sum3 << ' ' 
+		<< sum4 << '\n';
+}
+
+void benchmark_polyspace()
+{	
+	const double c0 = 0.5, c1 = -1.25, c2 = 3.0, c3 = 0.75;
+	double sum1, sum2;
+
+	auto horner = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto x : loop::linspace(-2., 3., n))
+			{
+				sum += ((c3 * x + c2) * x + c1) * x + c0;
+			}
+			sum1 = sum;
+		};
+
+	auto polyspace = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto p : loop::polyspace({ c0, c1, c2, c3 }, loop::linspace(-2., 3., n)))
+			{
+				sum += p;
+			}
+			sum2 = sum;
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("Horner(linspace())", 10, horner,    "steps", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("polyspace()",        10, polyspace, "steps", { 10, 100, 1000, 10000, 100000 }); 
+
+    bm.serialize("cubic polynomial values", "polyspace.results.txt");
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << '\n';
+}
+
+void benchmark_bucketize()
+{	
+	std::vector<double> x(100000);
+	std::mt19937 random(1);
+	std::uniform_real_distribution<double> uniform(-1.1, 1.1);
+	for (auto& xi : x) xi = uniform(random);
+
+	std::vector<int> bins(x.size());
+	std::size_t sum1 = 0, sum2 = 0, sum3 = 0;
+
+	auto upper_bound = [&](int n) 
+		{  
+			std::vector<double> edges;
+			for (auto e : loop::linspace(-1., 1., n)) edges.push_back(e);
+			for (std::size_t k = 0; k < x.size(); ++k)
+			{
+				bins[k] = int(std::upper_bound(edges.begin(), edges.end(), x[k]) - edges.begin());
+			}
+			sum1 += std::size_t(bins[0]);
+		};
+
+	auto bucketize = [&](int n) 
+		{  
+			loop::bucketize(loop::linspace(-1., 1., n), x.begin(), x.end(), bins.begin());
+			sum2 += std::size_t(bins[0]);
+		};
+
+	auto histogram = [&](int n) 
+		{  
+			sum3 += loop::histogram(loop::linspace(-1., 1., n), x.begin(), x.end())[1];
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("upper_bound(vector)", 10, upper_bound, "bins", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("bucketize()",         10, bucketize,   "bins", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("histogram()",         10, histogram,   "bins", { 10, 100, 1000, 10000, 100000 }); 
+
+    bm.serialize("bins of 100000 samples", "bucketize.results.txt");
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << ' '
+		<< sum3 << '\n';
+}
+
+void benchmark_tabulate()
+{	
+	std::vector<double> x(100000), y(x.size());
+	std::mt19937 random(1);
+	std::uniform_real_distribution<double> uniform(0., 1.);
+	for (auto& xi : x) xi = uniform(random);
+
+	auto table = loop::tabulate([](double t) { return std::exp(t); }, loop::linspace(0., 1., 1024));
+	double sum1 = 0, sum2 = 0, sum3 = 0;
+
+	auto exp = [&](int n) 
+		{  
+			for (int k = 0; k < n; ++k) y[k] = std::exp(x[k]);
+			sum1 += y[0];
+		};
+
+	auto linear = [&](int n) 
+		{  
+			table.linear(x.begin(), x.begin() + n, y.begin());
+			sum2 += y[0];
+		};
+
+	auto cubic = [&](int n) 
+		{  
+			table.cubic(x.begin(), x.begin() + n, y.begin());
+			sum3 += y[0];
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("exp(x)",         10, exp,    "samples", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("table.linear()", 10, linear, "samples", { 10, 100, 1000, 10000, 100000 }); 
+    bm.run("table.cubic()",  10, cubic,  "samples", { 10, 100, 1000, 10000, 100000 }); 
+
+    bm.serialize("exp(x) tabulated on 1025 values", "tabulate.results.txt");
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << ' '
+		<< sum3 << '\n';
+}
+
+void benchmark_integrate()
+{	
+	auto f = [](double x) { return 1 / (1 + x * x); };
+	double sum1 = 0, sum2 = 0, sum3 = 0, sum4 = 0, sum5 = 0;
+
+	auto naive = [&](int n) 
+		{  
+			double sum = 0;
+			for (auto x : loop::linspace(0., 1., n)) sum += f(x);
+			sum1 += sum / n;
+		};
+
+	auto trapezoid = [&](int n) 
+		{  
+			sum2 += loop::integrate(f, loop::linspace(0., 1., n), loop::quadrature::trapezoid{}, 1);
+		};
+
+	auto simpson = [&](int n) 
+		{  
+			sum3 += loop::integrate(f, loop::linspace(0., 1., n), loop::quadrature::simpson{}, 1);
+		};
+
+	auto gauss = [&](int n) 
+		{  
+			sum4 += loop::integrate(f, loop::linspace(0., 1., n / 3), loop::quadrature::gauss_legendre<3>{}, 1);
+		};
+
+	auto parallel = [&](int n) 
+		{  
+			sum5 += loop::integrate(f, loop::linspace(0., 1., n), loop::quadrature::simpson{});
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("sum += f(x)",               10, naive,     "values of f", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("trapezoid, 1 thread",       10, trapezoid, "values of f", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("simpson, 1 thread",         10, simpson,   "values of f", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("gauss_legendre<3>, 1 thread", 10, gauss,   "values of f", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("simpson, all cores",        10, parallel,  "values of f", { 100, 1000, 10000, 100000, 1000000 }); 
+
+    bm.serialize("integral of 1/(1+x^2) over [0, 1]", "integrate.results.txt");
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << ' '
+		<< sum3 << ' '
+		<< sum4 << ' '
+		<< sum5 << '\n';
+}
+
+void benchmark_closed_form()
+{	
+	int a = 1, step = 3;
+	long long sum1 = 0, sum2 = 0, sum3 = 0, sum4 = 0, sum5 = 0, sum6 = 0;
+
+	auto accumulate = [&](int n) 
+		{  
+			auto r = loop::range(a, n, step);
+			sum1 += std::accumulate(r.begin(), r.end(), 0LL);
+		};
+
+	auto sum = [&](int n) 
+		{  
+			sum2 += loop::range(a, n, step).sum();
+		};
+
+	auto std_lower_bound = [&](int n) 
+		{  
+			auto r = loop::range(a, n, step);
+			sum3 += *std::lower_bound(r.begin(), r.end(), n / 2);
+		};
+
+	auto lower_bound = [&](int n) 
+		{  
+			sum4 += *loop::range(a, n, step).lower_bound(n / 2);
+		};
+
+	// the values of the second half, clipped to the tile [n/2, n)
+	auto filter = [&](int n) 
+		{  
+			long long count = 0;
+			for (auto x : loop::range(a, n, step)) count += x >= n / 2;
+			sum5 += count;
+		};
+
+	auto intersection = [&](int n) 
+		{  
+			sum6 += loop::range(a, n, step).intersection(loop::range(n / 2, n)).size();
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("std::accumulate",  10, accumulate,      "n", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("sum()",            10, sum,             "n", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("std::lower_bound", 10, std_lower_bound, "n", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("lower_bound()",    10, lower_bound,     "n", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("clip by filter",   10, filter,          "n", { 100, 1000, 10000, 100000, 1000000 }); 
+    bm.run("intersection()",   10, intersection,    "n", { 100, 1000, 10000, 100000, 1000000 }); 
+
+    bm.serialize("algorithms on range(1, n, 3)", "closedform.results.txt");
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << ' '
+		<< sum3 << ' '
+		<< sum4 << ' '
+		<< sum5 << ' '
+		<< sum6 << '\n';
+}
+
+void benchmark_checkpoint()
+{	
+	const char* path = "bm_loop.cursor";
+	long long sum1 = 0, sum2 = 0, sum3 = 0;
+
+	auto plain = [&](int n) 
+		{  
+			for (auto i : loop::range(0LL, (long long)n)) sum1 += i * i;
+		};
+
+	auto counted = [&](int n) 
+		{  
+			auto job = loop::checkpoint(loop::range(0LL, (long long)n), path, 0, std::chrono::hours(1));
+			for (auto i : job.remaining()) { sum2 += i * i; ++job; }
+		};
+
+	auto saving = [&](int n) 
+		{  
+			std::remove(path);
+			auto job = loop::checkpoint(loop::range(0LL, (long long)n), path, 100000, std::chrono::seconds(1));
+			for (auto i : job.remaining()) { sum3 += i * i; ++job; }
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("plain loop",             10, plain,   "values", { 1000, 10000, 100000, 1000000, 10000000 }); 
+    bm.run("checkpoint, no saves",   10, counted, "values", { 1000, 10000, 100000, 1000000, 10000000 }); 
+    bm.run("checkpoint every 1e5",   10, saving,  "values", { 1000, 10000, 100000, 1000000, 10000000 }); 
+
+    bm.serialize("checkpointed loops", "checkpoint.results.txt");
+	std::remove(path);
+	
+	std::cout 
+		<< sum1 << ' ' 
+		<< sum2 << ' '
+		<< sum3 << '\n';
+}
+
 void benchmark_range()
 {	
 	int a = 1, step = 1;
@@ -158,10 +643,55 @@ void benchmark_range()
 		<< sum2 << '\n';
 }
 
+void benchmark_latency()
+{	
+	int a = 1, n = 1000, step = 1;
+	long long sum = 0;
+
+	auto range = [&]() 
+		{  
+			for (auto x : loop::range(a, n, step))
+			{
+				sum += x;
+			}
+			bmk::doNotOptimizeAway(sum);
+		};	
+
+	auto linspace = [&]() 
+		{  
+			double s = 0;
+			for (auto x : loop::linspace(0., 1., n))
+			{
+				s += x;
+			}
+			bmk::doNotOptimizeAway(s);
+		};	
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run_latency("range()",    1000000, range); 
+    bm.run_latency("linspace()", 1000000, linspace); 
+
+    bm.serialize("latency of 1000 step loops", "latency.results.txt");
+
+	std::cout << sum << '\n';
+}
+
 int main()
 {
 	benchmark_linspace();
+	benchmark_interpolation();
+	benchmark_ilinspace();
+	benchmark_logspace();
+	benchmark_trigonometric();
+	benchmark_polyspace();
+	benchmark_bucketize();
+	benchmark_tabulate();
+	benchmark_integrate();
+	benchmark_closed_form();
+	benchmark_checkpoint();
 	benchmark_range();
+	benchmark_latency();
 	/*
 	for (int i = 2; i <= 50; ++i)
 	{
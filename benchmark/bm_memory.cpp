@@ -0,0 +1,219 @@
+// range-indexed memory access vs. pointer and index loops
+// for arrays sized from L1 cache to main memory
+
+#include <vector>
+#include <cstddef>
+#include <iostream>
+#include "../loop.h"
+#include "benchmark.h"
+
+// array size in KiB: L1, L2, last level cache, main memory
+#define SIZES { 16, 256, 4096, 65536 }
+
+// every experiment touches the same amount of memory (passes * array size)
+const std::size_t total_bytes = std::size_t(64) << 20;
+const std::size_t stride = 16; // elements, i.e. 2 cache lines for double
+
+using Data = std::vector<double>;
+
+std::size_t elements(std::size_t kib) { return kib * 1024 / sizeof(double); }
+std::size_t passes(std::size_t kib)   { return total_bytes / (kib * 1024); }
+
+void benchmark_load(Data& data)
+{
+	double sum = 0;
+
+	auto pointer = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			double s = 0;
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (auto p = a, e = a + n; p != e; ++p) s += *p;
+			}
+			sum += s;
+		};
+
+	auto index = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			double s = 0;
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (std::size_t i = 0; i < n; ++i) s += a[i];
+			}
+			sum += s;
+		};
+
+	auto range = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			double s = 0;
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (auto i : loop::range(n)) s += a[i];
+			}
+			sum += s;
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("pointer", 10, pointer, "KiB", SIZES);
+    bm.run("i<n",     10, index,   "KiB", SIZES);
+    bm.run("range()", 10, range,   "KiB", SIZES);
+
+    bm.serialize("load: sum += a[i]", "memory_load.results.txt");
+
+	std::cout << sum << '\n';
+}
+
+void benchmark_store(Data& data)
+{
+	auto pointer = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (auto p = a, e = a + n; p != e; ++p) *p = double(pass);
+			}
+		};
+
+	auto index = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (std::size_t i = 0; i < n; ++i) a[i] = double(pass);
+			}
+		};
+
+	auto range = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (auto i : loop::range(n)) a[i] = double(pass);
+			}
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("pointer", 10, pointer, "KiB", SIZES);
+    bm.run("i<n",     10, index,   "KiB", SIZES);
+    bm.run("range()", 10, range,   "KiB", SIZES);
+
+    bm.serialize("store: a[i] = c", "memory_store.results.txt");
+
+	std::cout << data[0] << '\n';
+}
+
+void benchmark_gather(Data& data)
+{
+	double sum = 0;
+
+	// same number of loads per pass as the contiguous kernels
+	auto pointer = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			double s = 0;
+			for (auto pass = passes(kib) * stride; pass; --pass)
+			{
+				for (auto p = a, e = a + n; p < e; p += stride) s += *p;
+			}
+			sum += s;
+		};
+
+	auto index = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			double s = 0;
+			for (auto pass = passes(kib) * stride; pass; --pass)
+			{
+				for (std::size_t i = 0; i < n; i += stride) s += a[i];
+			}
+			sum += s;
+		};
+
+	auto range = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			double s = 0;
+			for (auto pass = passes(kib) * stride; pass; --pass)
+			{
+				for (auto i : loop::range(std::size_t(0), n, stride)) s += a[i];
+			}
+			sum += s;
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("pointer", 10, pointer, "KiB", SIZES);
+    bm.run("i<n",     10, index,   "KiB", SIZES);
+    bm.run("range()", 10, range,   "KiB", SIZES);
+
+    bm.serialize("strided gather: sum += a[16*i]", "memory_gather.results.txt");
+
+	std::cout << sum << '\n';
+}
+
+void benchmark_update(Data& data)
+{
+	auto pointer = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (auto p = a, e = a + n; p != e; ++p) *p = *p * 0.5 + 1.0;
+			}
+		};
+
+	auto index = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (std::size_t i = 0; i < n; ++i) a[i] = a[i] * 0.5 + 1.0;
+			}
+		};
+
+	auto range = [&](std::size_t kib)
+		{
+			auto n = elements(kib);
+			auto a = data.data();
+			for (auto pass = passes(kib); pass; --pass)
+			{
+				for (auto i : loop::range(n)) a[i] = a[i] * 0.5 + 1.0;
+			}
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("pointer", 10, pointer, "KiB", SIZES);
+    bm.run("i<n",     10, index,   "KiB", SIZES);
+    bm.run("range()", 10, range,   "KiB", SIZES);
+
+    bm.serialize("read-modify-write: a[i] = a[i]*0.5 + 1", "memory_update.results.txt");
+
+	std::cout << data[0] << '\n';
+}
+
+int main()
+{
+	Data data(elements(65536), 1.0);
+
+	benchmark_load(data);
+	benchmark_store(data);
+	benchmark_gather(data);
+	benchmark_update(data);
+}
@@ -0,0 +1,173 @@
+// loop.h ranges vs. C++20 standard views and handwritten loops
+// requires C++20, see CMakeLists.txt
+
+#include <ranges>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include "../loop.h"
+#include "benchmark.h"
+
+// number of generated values: from L1 cache size to main memory
+// (the values are stored into an array of the same size)
+#define SIZES { 1u<<10, 1u<<14, 1u<<18, 1u<<22, 1u<<24 }
+
+namespace views = std::views;
+
+template <typename T>
+auto stride_view(T n, T step)
+{
+#if defined(__cpp_lib_ranges_stride)
+	return views::iota(T(0), T(n*step)) | views::stride(step);
+#else
+	// std::views::stride is C++23, closest C++20 equivalent:
+	return views::iota(T(0), n) | views::transform([step](T i) { return T(i*step); });
+#endif
+}
+
+template <typename T>
+void benchmark_integral(const char* type_name, const char* filename)
+{
+	std::vector<T> out(1u<<24);
+	T const step = 2;
+
+	auto hand_up = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (T i = 0; i < T(n); ++i) *p++ = i;
+		};
+
+	auto range_up = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (auto i : loop::range(T(0), T(n))) *p++ = i;
+		};
+
+	auto iota_up = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (auto i : views::iota(T(0), T(n))) *p++ = i;
+		};
+
+	auto hand_stride = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (T i = 0; i < T(n*step); i += step) *p++ = i;
+		};
+
+	auto range_stride = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (auto i : loop::range(T(0), T(n*step), step)) *p++ = i;
+		};
+
+	auto iota_stride = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (auto i : stride_view(T(n), step)) *p++ = i;
+		};
+
+	auto hand_down = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (T i = T(n); i-- > 0; ) *p++ = i;
+		};
+
+	auto countdown = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (auto i : loop::countdown(T(n))) *p++ = i;
+		};
+
+	auto iota_reverse = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (auto i : views::iota(T(0), T(n)) | views::reverse) *p++ = i;
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("i+=1",              10, hand_up,      "values", SIZES);
+    bm.run("range()",           10, range_up,     "values", SIZES);
+    bm.run("iota",              10, iota_up,      "values", SIZES);
+    bm.run("i+=2",              10, hand_stride,  "values", SIZES);
+    bm.run("range(0,n,2)",      10, range_stride, "values", SIZES);
+    bm.run("iota|stride(2)",    10, iota_stride,  "values", SIZES);
+    bm.run("i--",               10, hand_down,    "values", SIZES);
+    bm.run("countdown()",       10, countdown,    "values", SIZES);
+    bm.run("iota|reverse",      10, iota_reverse, "values", SIZES);
+
+    bm.serialize(type_name, filename);
+
+	std::cout << type_name << ": " << out[0] << ' ' << out[1] << '\n';
+}
+
+void benchmark_floating(const char* type_name, const char* filename)
+{
+	std::vector<double> out(1u<<24);
+	double const a = 1, b = 6;
+
+	auto hand = [&](std::size_t n)
+		{
+			auto p = out.data();
+			auto dx = (b - a)/(n-1);
+			for (std::size_t i = 0; i < n; ++i) *p++ = a + i*dx;
+		};
+
+	auto linspace = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (auto x : loop::linspace(a, b, n-1)) *p++ = x;
+		};
+
+	auto iota_transform = [&](std::size_t n)
+		{
+			auto p = out.data();
+			auto dx = (b - a)/(n-1);
+			for (auto x : views::iota(std::size_t(0), n)
+				| views::transform([=](std::size_t i) { return a + i*dx; })) *p++ = x;
+		};
+
+	auto hand_down = [&](std::size_t n)
+		{
+			auto p = out.data();
+			auto dx = (a - b)/(n-1);
+			for (std::size_t i = 0; i < n; ++i) *p++ = b + i*dx;
+		};
+
+	auto linspace_down = [&](std::size_t n)
+		{
+			auto p = out.data();
+			for (auto x : loop::linspace(b, a, n-1)) *p++ = x;
+		};
+
+	auto iota_reverse = [&](std::size_t n)
+		{
+			auto p = out.data();
+			auto dx = (b - a)/(n-1);
+			for (auto x : views::iota(std::size_t(0), n)
+				| views::transform([=](std::size_t i) { return a + i*dx; })
+				| views::reverse) *p++ = x;
+		};
+
+    bmk::benchmark<std::chrono::nanoseconds> bm;
+
+    bm.run("a+i*dx",            10, hand,           "values", SIZES);
+    bm.run("linspace(a,b)",     10, linspace,       "values", SIZES);
+    bm.run("iota|transform",    10, iota_transform, "values", SIZES);
+    bm.run("b+i*dx, dx<0",      10, hand_down,      "values", SIZES);
+    bm.run("linspace(b,a)",     10, linspace_down,  "values", SIZES);
+    bm.run("...|reverse",       10, iota_reverse,   "values", SIZES);
+
+    bm.serialize(type_name, filename);
+
+	std::cout << type_name << ": " << out[0] << ' ' << out[1] << '\n';
+}
+
+int main()
+{
+	benchmark_integral<std::int32_t>("int32_t loops vs. views", "views_int32.results.txt");
+	benchmark_integral<std::int64_t>("int64_t loops vs. views", "views_int64.results.txt");
+	benchmark_integral<unsigned>("unsigned loops vs. views", "views_unsigned.results.txt");
+	benchmark_floating("double loops vs. views", "views_double.results.txt");
+}
@@ -0,0 +1,11 @@
+# Compiles SOURCE to OBJECT and writes the diagnostics of the compiler to REPORT.
+# usage: cmake -DCOMPILER=... -DFLAGS="..." -DSOURCE=... -DOBJECT=... -DREPORT=... -P compiler_report.cmake
+
+separate_arguments(FLAGS UNIX_COMMAND "${FLAGS}")
+execute_process(COMMAND ${COMPILER} ${FLAGS} -c -o ${OBJECT} ${SOURCE}
+	RESULT_VARIABLE result
+	ERROR_FILE ${REPORT})
+if(NOT result EQUAL 0)
+	file(READ ${REPORT} errors)
+	message(FATAL_ERROR "${SOURCE}: compilation failed\n${errors}")
+endif()
@@ -0,0 +1,110 @@
+// Kernel pairs compiled to assembly by CMake and compared by codegen.test.cpp:
+// each range_<name> must compile to the same code as its hand_<name> loop.
+
+#include <cstddef>
+#include "loop.h"
+
+extern "C" {
+
+long long range_sum_int(int n)
+{
+	long long s = 0;
+	for (auto i : loop::range(n)) s += i;
+	return s;
+}
+
+long long hand_sum_int(int n)
+{
+	long long s = 0;
+	for (int i = 0; i < n; ++i) s += i;
+	return s;
+}
+
+void range_store_size(int* p, std::size_t n)
+{
+	for (auto i : loop::range(n)) p[i] = int(i);
+}
+
+void hand_store_size(int* p, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i) p[i] = int(i);
+}
+
+void range_scale(float* p, int n, float f)
+{
+	for (auto i : loop::range(n)) p[i] *= f;
+}
+
+void hand_scale(float* p, int n, float f)
+{
+	for (int i = 0; i < n; ++i) p[i] *= f;
+}
+
+void range_step(int* p, int a, int b, int s)
+{
+	for (auto i : loop::range(a, b, s)) p[i] = i;
+}
+
+void hand_step(int* p, int a, int b, int s)
+{
+	for (int i = a; i < b; i += s) p[i] = i;
+}
+
+void range_step_down(int* p, int a, int b)
+{
+	for (auto i : loop::range(a, b, loop::step<-1>())) p[i] = i;
+}
+
+void hand_step_down(int* p, int a, int b)
+{
+	for (int i = a; i > b; --i) p[i] = i;
+}
+
+void range_countdown(int* p, int n)
+{
+	for (auto i : loop::countdown(n)) p[i] = i;
+}
+
+void hand_countdown(int* p, int n)
+{
+	for (int i = n - 1; i >= 0; --i) p[i] = i;
+}
+
+void range_linspace_store(double* p, double a, double b, int n)
+{
+	for (auto x : loop::linspace(a, b, n)) *p++ = x;
+}
+
+void hand_linspace_store(double* p, double a, double b, int n)
+{
+	auto dx = (b - a) * (1 / double(n));
+	for (int i = 0; i <= n; ++i) p[i] = a + i * dx;
+}
+
+void range_linspace_fixed(double* p, double a, double b)
+{
+	for (auto x : loop::linspace<8>(a, b)) *p++ = x;
+}
+
+void hand_linspace_fixed(double* p, double a, double b)
+{
+	auto dx = (b - a) * (1 / 8.);
+	for (int i = 0; i <= 8; ++i) p[i] = a + i * dx;
+}
+
+double range_linspace_sum(double a, double b, int n)
+{
+	double s = 0;
+	for (auto x : loop::linspace(a, b, n)) s += x;
+	return s;
+}
+
+double hand_linspace_sum(double a, double b, int n)
+{
+	double s = 0;
+	auto dx = (b - a) * (1 / double(n));
+	for (int i = 0; i <= n; ++i) s += a + i * dx;
+	return s;
+}
+
+} // extern "C"
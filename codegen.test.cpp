@@ -0,0 +1,206 @@
+// Compares the assembly of the kernel pairs in codegen.kernels.cpp:
+// lazy ranges shall not add instructions, loops or lose vectorization.
+// LOOP_CODEGEN_ASM names the assembly file generated by CMake (x86-64, AT&T syntax).
+
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include "catch.hpp"
+
+namespace {
+
+struct Instruction
+{
+	std::string mnemonic, operands;
+};
+
+struct Kernel
+{
+	std::vector<Instruction> code;
+	std::vector<std::vector<Instruction>> loops; // bodies of backward jumps
+
+	static bool packed(const Instruction& i)
+	{
+		static const std::regex simd("^v?(p[a-z]|[a-z]+p[sd]$|movdq|movap|movup|shufp|unpck)");
+		static const std::regex vreg("%[xyz]mm");
+		return std::regex_search(i.operands, vreg) && std::regex_search(i.mnemonic, simd);
+	}
+
+	static std::size_t count_packed(const std::vector<Instruction>& code)
+	{
+		return std::count_if(code.begin(), code.end(), packed);
+	}
+
+	bool vectorized() const { return count_packed(code) > 0; }
+
+	// the loop with most SIMD instructions, else the largest loop
+	std::vector<Instruction> hot_loop() const
+	{
+		std::vector<Instruction> hot;
+		for (auto& loop : loops)
+		{
+			auto key = [](const std::vector<Instruction>& l)
+				{ return std::make_pair(count_packed(l), l.size()); };
+			if (hot.empty() || key(loop) > key(hot)) hot = loop;
+		}
+		return hot;
+	}
+};
+
+std::string shape(const std::vector<Instruction>& code)
+{
+	std::vector<std::string> mnemonics;
+	for (auto& i : code) mnemonics.push_back(i.mnemonic);
+	std::sort(mnemonics.begin(), mnemonics.end());
+
+	std::string result;
+	for (auto& m : mnemonics) result += m + ' ';
+	return result;
+}
+
+// split the assembly into functions, dropping directives, labels and comments
+std::map<std::string, Kernel> parse(const char* filename)
+{
+	std::map<std::string, Kernel> kernels;
+	std::ifstream is(filename);
+	std::string line;
+	Kernel* current = nullptr;
+	std::map<std::string, std::size_t> labels;
+
+	while (std::getline(is, line))
+	{
+		auto comment = line.find('#');
+		if (comment != std::string::npos) line.erase(comment);
+
+		std::istringstream tokens(line);
+		std::string first, rest;
+		if (!(tokens >> first)) continue;
+		std::getline(tokens, rest);
+		rest.erase(0, rest.find_first_not_of(" \t"));
+
+		if (first.back() == ':' && first[0] != '.')
+		{
+			auto name = first.substr(0, first.size() - 1);
+			if (name.compare(0, 7, "_range_") == 0 || name.compare(0, 6, "_hand_") == 0)
+			{
+				name.erase(0, 1); // Mach-O symbol prefix
+			}
+			current = &kernels[name];
+			labels.clear();
+		}
+		else if (!current)
+		{
+			continue;
+		}
+		else if (first == ".cfi_endproc")
+		{
+			current = nullptr;
+		}
+		else if (first.back() == ':')
+		{
+			labels[first.substr(0, first.size() - 1)] = current->code.size();
+		}
+		else if (first[0] != '.')
+		{
+			current->code.push_back({ first, rest });
+
+			auto target = labels.find(rest);
+			if (first[0] == 'j' && target != labels.end())
+			{
+				current->loops.emplace_back(
+					current->code.begin() + target->second, current->code.end());
+			}
+		}
+	}
+	return kernels;
+}
+
+const std::map<std::string, Kernel>& kernels()
+{
+	static auto all = parse(LOOP_CODEGEN_ASM);
+	return all;
+}
+
+void require_parity(const std::string& name)
+{
+	auto lazy = kernels().find("range_" + name);
+	auto hand = kernels().find("hand_" + name);
+	REQUIRE(lazy != kernels().end());
+	REQUIRE(hand != kernels().end());
+
+	auto& r = lazy->second;
+	auto& h = hand->second;
+	auto rhot = r.hot_loop(), hhot = h.hot_loop();
+
+	INFO("range_" << name << ": " << r.code.size() << " instructions, "
+		<< r.loops.size() << " loops, hot loop: " << shape(rhot));
+	INFO("hand_"  << name << ": " << h.code.size() << " instructions, "
+		<< h.loops.size() << " loops, hot loop: " << shape(hhot));
+
+	// lost vectorization
+	if (h.vectorized()) REQUIRE(r.vectorized());
+	REQUIRE(Kernel::count_packed(rhot) >= Kernel::count_packed(hhot));
+
+	// loop overhead: no additional loops, the hot loop at most one instruction longer
+	REQUIRE(r.loops.size() <= h.loops.size());
+	REQUIRE(rhot.size() <= hhot.size() + 1);
+
+	// setup overhead: about the same number of instructions
+	REQUIRE(r.code.size() <= h.code.size() + h.code.size() / 8 + 4);
+}
+
+} // end namespace
+
+TEST_CASE("codegen: assembly of kernels available", "[codegen]")
+{
+	REQUIRE(kernels().size() >= 2u);
+}
+
+TEST_CASE("codegen: range(n) int sum", "[codegen]")
+{
+	require_parity("sum_int");
+}
+
+TEST_CASE("codegen: range(n) size_t store", "[codegen]")
+{
+	require_parity("store_size");
+}
+
+TEST_CASE("codegen: range(n) float scale", "[codegen]")
+{
+	require_parity("scale");
+}
+
+TEST_CASE("codegen: range(a, b, step) store", "[codegen]")
+{
+	require_parity("step");
+}
+
+TEST_CASE("codegen: range(a, b, step<-1>()) store", "[codegen]")
+{
+	require_parity("step_down");
+}
+
+TEST_CASE("codegen: countdown(n) store", "[codegen]")
+{
+	require_parity("countdown");
+}
+
+TEST_CASE("codegen: linspace(a, b, n) store", "[codegen]")
+{
+	require_parity("linspace_store");
+}
+
+TEST_CASE("codegen: linspace<8>(a, b) store", "[codegen]")
+{
+	require_parity("linspace_fixed");
+}
+
+TEST_CASE("codegen: linspace(a, b, n) sum", "[codegen]")
+{
+	require_parity("linspace_sum");
+}
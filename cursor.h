@@ -0,0 +1,353 @@
+#ifndef LOOP_CURSOR_H
+#define LOOP_CURSOR_H
+
+// checkpoint and resume of loops over range() and linspace(): binary
+// cursors and a checkpointer with amortized clock reads
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "loop.h"
+
+namespace loop {
+
+// ---[ cursors ]----------------------------------
+
+// Position in the values of a range(), as a versioned binary record:
+// the first and last value and the step identify the values, the index
+// of the next value is the position. Integers are little endian in 16
+// bytes, two's complement extended from the width of the counter:
+//   0 magic "LPCR", 4 version, 6 width, 7 flags (1 signed, 2 empty,
+//   4 finished, 8 floating), 8 first, 24 last, 40 step, 56 next, 72 zero,
+//   76 FNV-1a hash of the bytes 0...75
+// For linspace() the first and last value are stored as their bits, the
+// width is the size of the float, and the number of values replaces the
+// step.
+using cursor = std::array<unsigned char, 80>;
+
+constexpr std::uint16_t cursor_version = 1;
+
+namespace detail {
+
+enum cursor_flag : unsigned char { signed_counter = 1, empty_range = 2, finished_range = 4, floating_values = 8 };
+
+constexpr std::size_t cursor_next = 56, cursor_hash = 76;
+
+template <typename W>
+void put_integer(unsigned char* p, W x)
+{
+	auto u = make_unsigned_t<W>(x);
+	const unsigned char extension = x < W(0) ? 0xff : 0;
+	for (std::size_t k = 0; k < 16; ++k)
+	{
+		p[k] = k < sizeof(W) ? static_cast<unsigned char>(u & 0xff) : extension;
+		if (k + 1 < sizeof(W)) u = make_unsigned_t<W>(u >> 8);
+	}
+}
+
+template <typename I>
+I get_integer(const unsigned char* p)
+{
+	I x = 0;
+	for (std::size_t k = sizeof(I); k-- > 0; ) x = I(x << 8 | p[k]);
+	return x;
+}
+
+inline std::uint32_t fnv1a(const unsigned char* p, std::size_t n)
+{
+	std::uint32_t h = 2166136261u;
+	for (std::size_t k = 0; k < n; ++k) h = (h ^ p[k]) * 16777619u;
+	return h;
+}
+
+// the header of a cursor, with flags and the width of the values
+inline cursor cursor_header(std::size_t width, unsigned flags)
+{
+	cursor c{};
+	c[0] = 'L'; c[1] = 'P'; c[2] = 'C'; c[3] = 'R';
+	c[4] = cursor_version & 0xff;
+	c[5] = cursor_version >> 8;
+	c[6] = static_cast<unsigned char>(width);
+	c[7] = static_cast<unsigned char>(flags);
+	return c;
+}
+
+// the position and the hash, which complete a cursor
+inline cursor cursor_record(cursor c, std::uint64_t next)
+{
+	put_integer(&c[cursor_next], c[7] & finished_range ? std::uint64_t(0) : next);
+
+	const auto h = fnv1a(c.data(), cursor_hash);
+	for (std::size_t k = 0; k < 4; ++k) c[cursor_hash + k] = static_cast<unsigned char>(h >> 8 * k);
+	return c;
+}
+
+// cursor at the value with index next, finished past the last value
+template <typename T, typename W, typename Step, bool Wrap>
+cursor make_cursor(const IntegralRangeGenerator<T, W, Step, Wrap>& r, std::uint64_t next, bool finished)
+{
+	using U = make_unsigned_t<W>;
+	cursor c = cursor_header(sizeof(W),
+		(W(-1) < W(0) ? signed_counter : 0) | (r.empty() ? empty_range | finished_range : 0) | (finished ? finished_range : 0));
+
+	// the step as the difference of the values, unique for any step type
+	if (!r.empty())
+	{
+		put_integer(&c[8],  W(r.front()));
+		put_integer(&c[24], W(r.back()));
+		put_integer(&c[40], r.size() != 1 ? W(U(W(r[1])) - U(W(r.front()))) : W(0));
+	}
+	return cursor_record(c, next);
+}
+
+// the bits of a float or double
+template <typename Domain>
+auto float_bits(Domain x)
+{
+	using Bits = std::conditional_t<sizeof(Domain) == 4, std::uint32_t, std::uint64_t>;
+	static_assert(std::is_floating_point<Domain>::value && sizeof(Domain) == sizeof(Bits), "float or double values required");
+	Bits u;
+	std::memcpy(&u, &x, sizeof(u));
+	return u;
+}
+
+// cursor of linspace() values: the values with index 0 and size()-1 as
+// computed by operator[], the interpolation mode is not recorded
+template <typename Domain, typename N, typename Mode>
+cursor make_cursor(const LinearGenerator<Domain, N, Mode>& r, std::uint64_t next, bool finished)
+{
+	const bool empty = r.size() == 0;
+	cursor c = cursor_header(sizeof(Domain),
+		floating_values | (empty ? empty_range | finished_range : 0) | (finished ? finished_range : 0));
+
+	if (!empty)
+	{
+		put_integer(&c[8],  float_bits(r[0]));
+		put_integer(&c[24], float_bits(r[r.size() - 1]));
+		put_integer(&c[40], std::uint64_t(r.size()));
+	}
+	return cursor_record(c, next);
+}
+
+// the position of c in the values of r, false if c does not belong to them
+template <typename Range>
+bool cursor_position(const Range& r, const cursor& c, std::uint64_t& next, bool& finished)
+{
+	next = get_integer<std::uint64_t>(&c[cursor_next]);
+	finished = (c[7] & finished_range) != 0;
+	return make_cursor(r, next, finished) == c;
+}
+
+// the values of r from the position next on, none if finished
+template <typename T, typename W, typename Step, bool Wrap>
+auto values_from(const IntegralRangeGenerator<T, W, Step, Wrap>& r, std::uint64_t next, bool finished)
+{
+	return finished ? r.first(0) : r.drop(std::size_t(next));
+}
+
+template <typename Domain, typename N, typename Mode>
+auto values_from(const LinearGenerator<Domain, N, Mode>& r, std::uint64_t next, bool finished)
+{
+	return r.drop(finished ? r.size() : std::size_t(next));
+}
+
+} // end namespace detail
+
+// the cursor at iterator it of r
+template <typename T, typename W, typename Step, bool Wrap>
+cursor make_cursor(const detail::IntegralRangeGenerator<T, W, Step, Wrap>& r,
+	typename detail::IntegralRangeGenerator<T, W, Step, Wrap>::iterator it)
+{
+	return detail::make_cursor(r, std::uint64_t(it - r.begin()), it == r.end());
+}
+
+// the cursor after done values of r
+template <typename T, typename W, typename Step, bool Wrap>
+cursor make_cursor(const detail::IntegralRangeGenerator<T, W, Step, Wrap>& r, std::uint64_t done)
+{
+	const bool finished = r.size() != 0 && done >= r.size();
+	return detail::make_cursor(r, done, finished);
+}
+
+// the cursor after done values of linspace() values r
+template <typename Domain, typename N, typename Mode>
+cursor make_cursor(const detail::LinearGenerator<Domain, N, Mode>& r, std::uint64_t done)
+{
+	const bool finished = r.size() != 0 && done >= r.size();
+	return detail::make_cursor(r, done, finished);
+}
+
+// the values of r from the position of c on, O(1): all of r if c is
+// damaged, of another version or of other values
+template <typename Range>
+auto resume(const Range& r, const cursor& c)
+{
+	std::uint64_t next;
+	bool finished;
+	if (!detail::cursor_position(r, c, next, finished)) return detail::values_from(r, 0, false);
+	return detail::values_from(r, next, finished);
+}
+
+// Writes c to a temporary file renamed to path, which replaces the
+// previous cursor atomically: a reader sees the old or the new cursor, 
+// never a part. On POSIX systems the file and its directory are synced, 
+// so the cursor survives a crash of the system once true is returned. 
+// Elsewhere false if rename() cannot replace the previous cursor.
+inline bool save_cursor(const cursor& c, const std::string& path)
+{
+	const std::string temporary = path + ".tmp";
+#if defined(__unix__) || defined(__APPLE__)
+	const int file = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (file < 0) return false;
+	bool written = ::write(file, c.data(), c.size()) == ssize_t(c.size()) && ::fsync(file) == 0;
+	written = ::close(file) == 0 && written;
+	if (!written || std::rename(temporary.c_str(), path.c_str()) != 0)
+	{
+		std::remove(temporary.c_str());
+		return false;
+	}
+
+	const auto slash = path.find_last_of('/');
+	const std::string directory = slash == std::string::npos ? "." : path.substr(0, slash ? slash : 1);
+	const int parent = ::open(directory.c_str(), O_RDONLY);
+	if (parent < 0) return false;
+	const bool synced = ::fsync(parent) == 0;
+	::close(parent);
+	return synced;
+#else
+	{
+		std::ofstream os(temporary, std::ios::binary | std::ios::trunc);
+		os.write(reinterpret_cast<const char*>(c.data()), std::streamsize(c.size()));
+		os.flush();
+		if (!os) return false;
+	}
+	return std::rename(temporary.c_str(), path.c_str()) == 0;
+#endif
+}
+
+// false if there is no complete cursor in path
+inline bool load_cursor(const std::string& path, cursor& c)
+{
+	std::ifstream is(path, std::ios::binary);
+	cursor record{};
+	is.read(reinterpret_cast<char*>(record.data()), std::streamsize(record.size()));
+	if (!is || is.gcount() != std::streamsize(record.size())) return false;
+	if (detail::get_integer<std::uint32_t>(&record[detail::cursor_hash]) != detail::fnv1a(record.data(), detail::cursor_hash)) return false;
+
+	c = record;
+	return true;
+}
+
+// ---[ checkpoints ]----------------------------------
+
+// Counts the values done in a loop over a range and saves their cursor
+// every `every` values (0: never) or after `interval`, whichever comes
+// first. ++ is a decrement and a branch: the clock is read once per
+// clock_stride values, and the count is exact at every save.
+//   auto job = checkpoint(range(0LL, n), "job.cursor", 1000000, std::chrono::seconds(30));
+//   for (auto i : job.remaining()) { work(i); ++job; }
+//   job.save();
+template <typename Range>
+class checkpointer
+{
+	using clock = std::chrono::steady_clock;
+public:
+	checkpointer(const Range& r, std::string path, std::uint64_t every, clock::duration interval, std::uint32_t clock_stride)
+	: range_(r), path_(std::move(path)), every_(every), interval_(interval),
+	  stride_(clock_stride ? clock_stride : 1), saved_(clock::now())
+	{
+		cursor c;
+		std::uint64_t next;
+		bool finished;
+		if (load_cursor(path_, c) && detail::cursor_position(range_, c, next, finished))
+		{
+			done_ = finished ? range_.size() : next;
+			finished_ = finished;
+			resumed_ = true;
+		}
+		reload();
+	}
+
+	// the values not done yet
+	auto remaining() const { return detail::values_from(range_, done(), finished_); }
+
+	// false if the loop started over: no cursor in path, a damaged one or
+	// one of other values
+	bool resumed() const { return resumed_; }
+
+	// modulo 2^64 for all 2^64 values of a 64 bit type
+	std::uint64_t done() const { return done_ + (batch_ - countdown_); }
+
+	checkpointer& operator++()
+	{
+		if (--countdown_ == 0) poll();
+		return *this;
+	}
+
+	// saves the cursor now, false on failure of the file system
+	bool save()
+	{
+		count(batch_ - countdown_);
+		since_save_ = 0;
+		saved_ = clock::now();
+		reload();
+
+		const bool finished = finished_ || (range_.size() != 0 && done_ >= range_.size());
+		return save_cursor(detail::make_cursor(range_, done_, finished), path_);
+	}
+private:
+	// k more values done: the count wraps around to 0 past the last of 
+	// all 2^64 values, which finishes the range
+	void count(std::uint64_t k)
+	{
+		done_ += k;
+		finished_ = finished_ || (k != 0 && done_ < k);
+	}
+
+	void poll()
+	{
+		count(batch_);
+		since_save_ += batch_;
+		batch_ = countdown_ = 0;
+		if ((every_ && since_save_ >= every_) || clock::now() - saved_ >= interval_) save();
+		else reload();
+	}
+
+	// the next clock read after stride values, or at the next save
+	void reload()
+	{
+		std::uint64_t batch = stride_;
+		if (every_ && every_ - since_save_ < batch) batch = every_ - since_save_;
+		batch_ = countdown_ = batch;
+	}
+
+	Range range_;
+	std::string path_;
+	std::uint64_t every_;
+	clock::duration interval_;
+	std::uint64_t stride_, done_ = 0, since_save_ = 0, batch_ = 0, countdown_ = 0;
+	bool finished_ = false, resumed_ = false;
+	clock::time_point saved_;
+};
+
+template <typename Range, typename Rep, typename Period>
+auto checkpoint(const Range& r, std::string path, std::uint64_t every,
+	std::chrono::duration<Rep, Period> interval, std::uint32_t clock_stride = 1024)
+{
+	return checkpointer<Range>(r, std::move(path), every,
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval), clock_stride);
+}
+
+} // end namespace loop
+
+#endif // LOOP_CURSOR_H
@@ -0,0 +1,218 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <vector>
+#include "catch.hpp"
+#include "cursor.h"
+
+TEST_CASE("cursors of integral ranges", "[cursor]")
+{
+	auto r = loop::range(5, 100, 3);
+	auto values = [](auto range) { return std::vector<long long>(range.begin(), range.end()); };
+
+	SECTION("record layout")
+	{
+		auto c = loop::make_cursor(r, r.begin() + 7);
+		REQUIRE(c.size() == 80u);
+		REQUIRE((c[0] == 'L' && c[1] == 'P' && c[2] == 'C' && c[3] == 'R'));
+		REQUIRE(c[4] == loop::cursor_version);
+		REQUIRE(c[6] == sizeof(int));
+		REQUIRE(c[8] == 5);
+		REQUIRE(c[24] == 98);
+		REQUIRE(c[40] == 3);
+		REQUIRE(c[56] == 7);
+		REQUIRE(loop::make_cursor(r, 7) == c);
+	}
+
+	SECTION("resume at the position")
+	{
+		REQUIRE(values(loop::resume(r, loop::make_cursor(r, r.begin()))) == values(r));
+		REQUIRE(values(loop::resume(r, loop::make_cursor(r, r.begin() + 30))) == std::vector<long long>({ 95, 98 }));
+		REQUIRE(loop::resume(r, loop::make_cursor(r, r.end())).empty());
+		REQUIRE(loop::resume(r, loop::make_cursor(r, 1000)).empty());
+
+		auto down = loop::range(40u, 0u, -3);
+		REQUIRE(loop::resume(down, loop::make_cursor(down, 12)).front() == 4u);
+
+		const auto max = std::numeric_limits<std::uint64_t>::max();
+		auto all = loop::range(std::uint64_t(0), max, std::uint64_t(1), true);
+		REQUIRE(loop::resume(all, loop::make_cursor(all, std::uint64_t(1) << 40)).front() == std::uint64_t(1) << 40);
+	}
+
+	SECTION("rejected for other values, damaged or other versions")
+	{
+		auto c = loop::make_cursor(r, 7);
+		REQUIRE(loop::resume(loop::range(5, 100, 2), c).size() == 48u);
+		REQUIRE(loop::resume(loop::range(5LL, 100LL, 3LL), c).size() == 32u);
+		REQUIRE(loop::resume(loop::range(5, 101, 3), c).size() == 25u); // the same values
+
+		auto damaged = c;
+		damaged[57] = 1;
+		REQUIRE(loop::resume(r, damaged).size() == 32u);
+
+		auto future = c;
+		future[4] = loop::cursor_version + 1;
+		REQUIRE(loop::resume(r, future).size() == 32u);
+	}
+
+	SECTION("saved and loaded as a file")
+	{
+		const char* path = "looptest.cursor";
+		auto c = loop::make_cursor(r, 11);
+		REQUIRE(loop::save_cursor(c, path));
+		REQUIRE(loop::save_cursor(c, path)); // replaces the previous cursor
+
+		loop::cursor loaded;
+		REQUIRE(loop::load_cursor(path, loaded));
+		REQUIRE(loaded == c);
+
+		{
+			std::ofstream torn(path, std::ios::binary | std::ios::trunc);
+			torn.write(reinterpret_cast<const char*>(c.data()), 40);
+		}
+		REQUIRE(!loop::load_cursor(path, loaded));
+		REQUIRE(!loop::load_cursor("looptest.missing.cursor", loaded));
+		std::remove(path);
+	}
+}
+
+TEST_CASE("cursors of linspace values", "[cursor]")
+{
+	auto r = loop::linspace(0., 1., 100);
+	auto values = [](auto range) { return std::vector<double>(range.begin(), range.end()); };
+
+	SECTION("record layout")
+	{
+		auto c = loop::make_cursor(r, 7);
+		REQUIRE(c[6] == sizeof(double));
+		REQUIRE(c[7] == 8);
+		REQUIRE(c[40] == 101);
+		REQUIRE(c[56] == 7);
+		REQUIRE(loop::make_cursor(r, 101)[7] == 8 + 4);
+	}
+
+	SECTION("resume at the position")
+	{
+		REQUIRE(values(loop::resume(r, loop::make_cursor(r, 0))) == values(r));
+		auto rest = loop::resume(r, loop::make_cursor(r, 99));
+		REQUIRE(rest.size() == 2u);
+		REQUIRE(values(rest) == std::vector<double>({ r[99], 1. }));
+		REQUIRE(loop::resume(r, loop::make_cursor(r, 1000)).size() == 0u);
+
+		auto open = loop::linspace(1.f, 0.f, 8u, loop::boundary::open);
+		REQUIRE(*loop::resume(open, loop::make_cursor(open, 3)).begin() == open[3]);
+	}
+
+	SECTION("rejected for other values")
+	{
+		auto c = loop::make_cursor(r, 7);
+		REQUIRE(loop::resume(loop::linspace(0., 1., 99), c).size() == 100u);
+		REQUIRE(loop::resume(loop::linspace(0.f, 1.f, 100), c).size() == 101u);
+		REQUIRE(loop::resume(loop::linspace(0., 1., 100, loop::boundary::open), c).size() == 99u);
+		REQUIRE(loop::resume(loop::range(0LL, 101LL), c).size() == 101u);
+	}
+}
+
+TEST_CASE("checkpoints of loops", "[cursor]")
+{
+	const char* path = "looptest.checkpoint.cursor";
+	std::remove(path);
+	auto r = loop::range(0LL, 100000LL);
+
+	SECTION("every K values, resumed after an interruption")
+	{
+		{
+			auto job = loop::checkpoint(r, path, 10000, std::chrono::hours(1), 64);
+			REQUIRE(!job.resumed());
+			for (auto i : job.remaining())
+			{
+				if (i == 25000) break;
+				++job;
+			}
+			REQUIRE(job.done() == 25000u);
+		}
+		auto job = loop::checkpoint(r, path, 10000, std::chrono::hours(1), 64);
+		REQUIRE(job.resumed());
+		REQUIRE(job.done() == 20000u);
+		REQUIRE(job.remaining().front() == 20000);
+
+		long long sum = 0;
+		for (auto i : job.remaining())
+		{
+			sum += i;
+			++job;
+		}
+		REQUIRE(job.save());
+		REQUIRE(sum == r.drop(20000).sum<long long>());
+
+		auto finished = loop::checkpoint(r, path, 0, std::chrono::hours(1));
+		REQUIRE(finished.remaining().empty());
+	}
+
+	SECTION("after the interval, at clock reads every clock_stride values")
+	{
+		auto job = loop::checkpoint(r, path, 0, std::chrono::nanoseconds(0), 1000);
+		for (auto i : loop::range(1500)) { (void)i; ++job; }
+
+		loop::cursor c;
+		REQUIRE(loop::load_cursor(path, c));
+		REQUIRE(loop::resume(r, c).front() == 1000);
+	}
+
+	SECTION("finished over all 2^64 values")
+	{
+		const auto max = std::numeric_limits<std::uint64_t>::max();
+		auto all = loop::range(std::uint64_t(0), max, std::uint64_t(1), true);
+		REQUIRE(loop::save_cursor(loop::make_cursor(all, all.end()), path));
+
+		auto job = loop::checkpoint(all, path, 0, std::chrono::hours(1));
+		REQUIRE(job.remaining().empty());
+		REQUIRE(job.save());
+
+		loop::cursor c;
+		REQUIRE(loop::load_cursor(path, c));
+		REQUIRE(loop::resume(all, c).empty());
+	}
+
+	SECTION("other values start over")
+	{
+		REQUIRE(loop::save_cursor(loop::make_cursor(loop::range(0, 10), 5), path));
+		auto job = loop::checkpoint(r, path, 10, std::chrono::hours(1));
+		REQUIRE(!job.resumed());
+		REQUIRE(job.done() == 0u);
+	}
+
+	SECTION("damaged cursors start over")
+	{
+		auto c = loop::make_cursor(r, 5);
+		c[57] = 1;
+		REQUIRE(loop::save_cursor(c, path));
+		auto job = loop::checkpoint(r, path, 10, std::chrono::hours(1));
+		REQUIRE(!job.resumed());
+		REQUIRE(job.done() == 0u);
+	}
+
+	SECTION("linspace values")
+	{
+		auto grid = loop::linspace(0., 1., 1000);
+		{
+			auto job = loop::checkpoint(grid, path, 100, std::chrono::hours(1), 16);
+			for (auto x : job.remaining())
+			{
+				if (x >= 0.25) break;
+				++job;
+			}
+		}
+		auto job = loop::checkpoint(grid, path, 100, std::chrono::hours(1), 16);
+		REQUIRE(job.resumed());
+		REQUIRE(job.done() == 200u);
+		REQUIRE(*job.remaining().begin() == grid[200]);
+
+		for (auto x : job.remaining()) { (void)x; ++job; }
+		REQUIRE(job.save());
+		REQUIRE(loop::checkpoint(grid, path, 0, std::chrono::hours(1)).remaining().size() == 0u);
+	}
+	std::remove(path);
+}
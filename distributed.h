@@ -0,0 +1,242 @@
+#ifndef LOOP_DISTRIBUTED_H
+#define LOOP_DISTRIBUTED_H
+
+// loops over range() in forked worker processes (POSIX): shards handed
+// out by a lock-free counter in shared memory, failed shards restarted
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "loop.h"
+#include "parallel.h"
+
+namespace loop {
+
+// ---[ distributed loops ]----------------------------------
+
+// results of distributed_for(): one value per shard, Result() for the
+// shards that failed in every attempt
+template <typename Result>
+struct shard_results
+{
+	std::vector<Result> values;
+	std::vector<std::size_t> failed;
+};
+
+namespace detail {
+
+// the counter and the flags are shared by processes: lock-free atomics
+// are address-free
+using shard_counter = std::uint64_t;
+using shard_flag = unsigned char;
+static_assert((std::is_same<shard_counter, unsigned long>::value ? ATOMIC_LONG_LOCK_FREE
+	: std::is_same<shard_counter, unsigned long long>::value ? ATOMIC_LLONG_LOCK_FREE : 0) == 2, "lock-free counter required");
+static_assert(ATOMIC_CHAR_LOCK_FREE == 2, "lock-free flags required");
+
+// anonymous memory for n objects T, shared with forked processes
+template <typename T>
+class shared_array
+{
+public:
+	explicit shared_array(std::size_t n)
+	: size_(std::max<std::size_t>(n, 1) * sizeof(T)),
+	  p_(mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0))
+	{
+	}
+	~shared_array() { if (p_ != MAP_FAILED) munmap(p_, size_); }
+
+	shared_array(const shared_array&) = delete;
+	shared_array& operator=(const shared_array&) = delete;
+
+	explicit operator bool() const { return p_ != MAP_FAILED; }
+	T* get() const { return static_cast<T*>(p_); }
+	T& operator[](std::size_t k) const { return get()[k]; }
+private:
+	std::size_t size_;
+	void* p_;
+};
+
+// a worker: shards queue[next++] until the queue is exhausted
+template <typename Range, typename Body, typename Result>
+void run_shards(const Range& r, Body& body, std::size_t shards, std::atomic<shard_counter>& next,
+	const std::uint64_t* queue, std::size_t queued, Result* values, std::atomic<shard_flag>* done)
+{
+	for (std::uint64_t k; (k = next.fetch_add(1, std::memory_order_relaxed)) < queued; )
+	{
+		const auto s = std::size_t(queue[k]);
+		new (values + s) Result(body(r.shard(s, shards)));
+		done[s].store(1, std::memory_order_release);
+	}
+}
+
+// a worker process and the read end of a pipe, which reaches its end
+// when the worker exits and the system closes the write end
+struct worker
+{
+	pid_t pid;
+	int fd;
+};
+
+// a forked worker exits without destructors and atexit handlers of the
+// parent, the exit status tells success; false if no worker started
+template <typename Run>
+bool spawn(Run& run, std::vector<worker>& workers)
+{
+	int fds[2];
+	if (pipe(fds) != 0) return false;
+
+	std::fflush(nullptr); // buffered output is not written twice
+	const pid_t pid = fork();
+	if (pid != 0)
+	{
+		close(fds[1]);
+		if (pid < 0) close(fds[0]);
+		else workers.push_back({ pid, fds[0] });
+		return pid > 0;
+	}
+
+	// only the own write end stays open in the worker
+	close(fds[0]);
+	for (auto& w : workers) close(w.fd);
+
+	int status = 0;
+	try { run(); }
+	catch (...) { status = 1; }
+	_exit(status);
+}
+
+// blocks until one of the workers ends and reaps it, no other child
+// process of the caller: false if none is left, failed unless it
+// exited with status 0
+inline bool wait_worker(std::vector<worker>& workers, bool& failed)
+{
+	if (workers.empty()) return false;
+
+	std::vector<pollfd> ends;
+	for (auto& w : workers) ends.push_back({ w.fd, POLLIN, 0 });
+	int ready;
+	while ((ready = poll(ends.data(), nfds_t(ends.size()), -1)) == -1 && errno == EINTR) {}
+
+	// without poll() the first worker is waited for
+	std::size_t k = 0;
+	while (ready > 0 && k + 1 < ends.size() && ends[k].revents == 0) ++k;
+
+	int status = 0;
+	pid_t pid;
+	while ((pid = waitpid(workers[k].pid, &status, 0)) == -1 && errno == EINTR) {}
+
+	// -1: reaped elsewhere (SIGCHLD ignored), the status is lost
+	failed = pid == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+	close(workers[k].fd);
+	workers.erase(workers.begin() + std::ptrdiff_t(k));
+	return true;
+}
+
+} // end namespace detail
+
+// Calls body(r.shard(s, shards)) for all shards s in forked worker
+// processes and gathers the results, which must be trivially copyable.
+// Each worker takes the next shard from a lock-free counter in shared
+// memory, so fast workers take more shards. A worker that crashes, is
+// killed or lets an exception escape is replaced at once; its shard
+// is run again in the next of at most `attempts` rounds.
+// workers = 0: one per core, shards = 0: 8 per worker. Without shared
+// memory or processes the shards run in the calling process, where
+// exceptions count as failures as well.
+template <typename Range, typename Body>
+auto distributed_for(const Range& r, Body body, unsigned workers = 0, std::size_t shards = 0, unsigned attempts = 3)
+{
+	using Result = std::decay_t<decltype(body(r.shard(0, 1)))>;
+	static_assert(std::is_trivially_copyable<Result>::value, "return a trivially copyable result per shard");
+
+	workers = detail::thread_count(std::numeric_limits<std::ptrdiff_t>::max(), workers, 1);
+	if (shards == 0) shards = std::max<std::size_t>(1, std::min<std::size_t>(std::size_t(8) * workers, r.size()));
+
+	shard_results<Result> results;
+	results.values.resize(shards);
+
+	detail::shared_array<std::atomic<detail::shard_counter>> next(1);
+	detail::shared_array<std::uint64_t> queue(shards);
+	detail::shared_array<Result> values(shards);
+	detail::shared_array<std::atomic<detail::shard_flag>> done(shards);
+
+	if (!next || !queue || !values || !done)
+	{
+		for (std::size_t s = 0; s < shards; ++s)
+		{
+			bool finished = false;
+			for (unsigned attempt = 0; attempt < attempts && !finished; ++attempt)
+			{
+				try { results.values[s] = body(r.shard(s, shards)); finished = true; }
+				catch (...) {}
+			}
+			if (!finished) results.failed.push_back(s);
+		}
+		return results;
+	}
+	new (next.get()) std::atomic<detail::shard_counter>(0);
+	for (std::size_t s = 0; s < shards; ++s) new (done.get() + s) std::atomic<detail::shard_flag>(0);
+
+	std::vector<std::size_t> pending(shards);
+	std::iota(pending.begin(), pending.end(), std::size_t(0));
+
+	for (unsigned round = 0; round < attempts && !pending.empty(); ++round)
+	{
+		std::copy(pending.begin(), pending.end(), queue.get());
+		next[0].store(0);
+
+		auto run = [&] { detail::run_shards(r, body, shards, next[0], queue.get(), pending.size(), values.get(), done.get()); };
+		auto exhausted = [&] { return next[0].load() >= pending.size(); };
+
+		// replacements for failed workers, at most one per shard
+		std::vector<detail::worker> running;
+		std::size_t replacements = pending.size();
+		for (std::size_t w = 0; w < std::min<std::size_t>(workers, pending.size()); ++w) detail::spawn(run, running);
+
+		// a shard that throws in the caller is skipped, the others run on
+		if (running.empty())
+		{
+			for (bool finished = false; !finished; )
+			{
+				try { run(); finished = true; }
+				catch (...) {}
+			}
+		}
+
+		for (bool failed; detail::wait_worker(running, failed); )
+		{
+			if (failed && !exhausted() && replacements > 0)
+			{
+				--replacements;
+				detail::spawn(run, running);
+			}
+		}
+
+		pending.erase(std::remove_if(pending.begin(), pending.end(),
+			[&](std::size_t s) { return done[s].load(std::memory_order_acquire) != 0; }), pending.end());
+	}
+
+	for (std::size_t s = 0; s < shards; ++s)
+	{
+		if (done[s].load(std::memory_order_acquire)) results.values[s] = values[s];
+	}
+	results.failed = pending;
+	return results;
+}
+
+} // end namespace loop
+
+#endif // LOOP_DISTRIBUTED_H
@@ -0,0 +1,95 @@
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include "catch.hpp"
+#include "distributed.h"
+
+TEST_CASE("loops over shards in worker processes", "[distributed]")
+{
+	auto r = loop::range(0LL, 1000000LL);
+	auto sum = [](auto shard) { return shard.template sum<long long>(); };
+
+	SECTION("results of all shards in the parent")
+	{
+		auto results = loop::distributed_for(r, sum, 4, 37);
+		REQUIRE(results.values.size() == 37u);
+		REQUIRE(results.failed.empty());
+
+		long long total = 0;
+		for (std::size_t s = 0; s < 37; ++s)
+		{
+			REQUIRE(results.values[s] == r.shard(s, 37).sum<long long>());
+			total += results.values[s];
+		}
+		REQUIRE(total == r.sum<long long>());
+	}
+
+	SECTION("default workers and shards, more workers than shards, empty ranges")
+	{
+		auto results = loop::distributed_for(r, sum);
+		REQUIRE(!results.values.empty());
+		REQUIRE(results.failed.empty());
+
+		auto few = loop::distributed_for(loop::range(10), [](auto shard) { return int(shard.size()); }, 8, 3);
+		REQUIRE(few.values == std::vector<int>({ 4, 3, 3 }));
+
+		auto none = loop::distributed_for(loop::range(0), [](auto shard) { return int(shard.size()); }, 2);
+		REQUIRE(none.values == std::vector<int>({ 0 }));
+		REQUIRE(none.failed.empty());
+	}
+
+	SECTION("a crashed worker is replaced, its shard restarted")
+	{
+		const char* marker = "looptest.crashed";
+		std::remove(marker);
+		auto results = loop::distributed_for(r, [&](auto shard)
+			{
+				if (shard.contains(500000LL) && !std::ifstream(marker))
+				{
+					std::ofstream(marker) << 1;
+					std::_Exit(9);
+				}
+				return shard.template sum<long long>();
+			}, 3, 20);
+
+		REQUIRE(std::ifstream(marker));
+		REQUIRE(results.failed.empty());
+		REQUIRE(results.values[10] == r.shard(10, 20).sum<long long>());
+		std::remove(marker);
+	}
+
+	SECTION("other child processes of the caller are not reaped")
+	{
+		const pid_t child = fork();
+		if (child == 0) _exit(7);
+		REQUIRE(child > 0);
+		usleep(10000);
+
+		auto results = loop::distributed_for(r, sum, 2, 16);
+		REQUIRE(results.failed.empty());
+
+		int status = 0;
+		REQUIRE(waitpid(child, &status, 0) == child);
+		REQUIRE(WIFEXITED(status));
+		REQUIRE(WEXITSTATUS(status) == 7);
+	}
+
+	SECTION("shards failing in every attempt")
+	{
+		auto results = loop::distributed_for(r, [](auto shard)
+			{
+				if (shard.contains(123456LL)) throw std::runtime_error("shard failed");
+				return shard.template sum<long long>();
+			}, 2, 8, 2);
+
+		REQUIRE(results.failed == std::vector<std::size_t>({ 0 }));
+		REQUIRE(results.values[0] == 0);
+		REQUIRE(results.values[1] == r.shard(1, 8).sum<long long>());
+	}
+}
+
+#endif
@@ -40,6 +40,12 @@ TEST_CASE("generic generator for int values", "[intgenerator]" )
 		for (auto i : loop::generate(8, 5, -2)) v.push_back(i);
 		REQUIRE(v == Vec({ 8, 6, 4, 2, 0 }));
 	}
+
+	SECTION("generate(8, 5, step<-2>())") 
+	{
+		for (auto i : loop::generate(8, 5, loop::step<-2>())) v.push_back(i);
+		REQUIRE(v == Vec({ 8, 6, 4, 2, 0 }));
+	}
 }
 
 TEST_CASE("generic generator for string values", "[stringgenerator]" ) 
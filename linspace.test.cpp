@@ -1,4 +1,10 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <tuple>
 #include <complex>
+#include <iterator>
+#include <random>
 #include <vector>
 #include "catch.hpp"
 #include "loop.h"
@@ -176,3 +182,536 @@ TEST_CASE("linspace iterator increment", "[linspace]")
 		
 	REQUIRE(i1 == i2);
 }
+
+TEST_CASE("linspace tables at compile time", "[linspace]")
+{
+	constexpr auto x = loop::to_array<5>(loop::linspace(0., 1., 4));
+	static_assert(x[0] == 0. && x[2] == 0.5 && x[4] == 1., "");
+
+	constexpr auto y = loop::to_array<1>(loop::linspace(0.f, 1.f, 2, loop::boundary::open));
+	static_assert(y[0] == 0.5f, "");
+
+	REQUIRE(x.size() == 5u);
+	REQUIRE(x[1] == 0.25);
+}
+
+TEST_CASE("linear spaced with compile-time count", "[linspace]")
+{
+	using Vec = std::vector<double>;
+	using loop::boundary;
+	Vec v, expected;
+
+	auto same = [&](auto fixed, auto runtime)
+		{
+			v.clear();
+			expected.clear();
+			for (auto x : fixed) v.push_back(x);
+			for (auto x : runtime) expected.push_back(x);
+			return v == expected;
+		};
+
+	REQUIRE(same(loop::linspace<4>(0., 1.), loop::linspace(0., 1., 4)));
+	REQUIRE(same(loop::linspace<4, boundary::rightopen>(0., 1.), loop::linspace(0., 1., 4, boundary::rightopen)));
+	REQUIRE(same(loop::linspace<4, boundary::leftopen>(0., 1.), loop::linspace(0., 1., 4, boundary::leftopen)));
+	REQUIRE(same(loop::linspace<4, boundary::open>(1., 0.), loop::linspace(1., 0., 4, boundary::open)));
+	REQUIRE(same(loop::linspace<1, boundary::open>(0., 1.), loop::linspace(0., 1., 1, boundary::open)));
+	REQUIRE(same(loop::linspace<0>(0., 1.), loop::linspace(0., 1., 0)));
+	REQUIRE(v.empty());
+
+	// a and dx only, count and boundary are constants
+	static_assert(sizeof(loop::linspace<8>(0., 1.)) == 2 * sizeof(double), "");
+	static_assert(decltype(loop::linspace<8, boundary::open>(0., 1.))::size() == 7, "");
+
+	constexpr auto x = loop::to_array<3>(loop::linspace<2>(0.f, 1.f));
+	static_assert(x[1] == 0.5f, "");
+}
+
+TEST_CASE("linear spaced with interpolation modes", "[linspace]")
+{
+	namespace interpolation = loop::interpolation;
+	const double a = 0.1, b = 0.7, u = std::numeric_limits<double>::epsilon() / 2;
+
+	// values and documented error bounds of each mode
+	auto check = [&](auto mode, int n, auto bound)
+		{
+			std::vector<double> v;
+			for (auto x : loop::linspace(a, b, n, loop::boundary::closed, mode)) v.push_back(x);
+			REQUIRE(v.size() == std::size_t(n + 1));
+
+			double dx = (b - a) / n;
+			for (int i = 0; i <= n; ++i)
+			{
+				long double exact = a + i * ((long double)b - a) / n;
+				INFO("n = " << n << ", i = " << i);
+				REQUIRE(std::abs(v[i] - exact) <= bound(i, std::abs(dx)) * u);
+			}
+			return v;
+		};
+
+	for (int n = 1; n <= 200; ++n)
+	{
+		check(interpolation::linear(), n, [&](int i, double dx) { return a + 5 * i * dx; });
+		check(interpolation::fma(), n, [&](int i, double dx) { return a + 4 * i * dx; });
+		check(interpolation::incremental(), n, [&](int i, double) { return (i + 3) * (a + b); });
+
+		auto v = check(interpolation::two_sided(), n, [&](int, double dx) { return b + 3 * n * dx; });
+		REQUIRE(v.front() == a);
+		REQUIRE(v.back() == b);
+	}
+
+	SECTION("two_sided hits both ends, also for open boundaries and b < a") 
+	{
+		std::vector<double> v;
+		for (auto x : loop::linspace(b, a, 7, loop::boundary::rightopen, interpolation::two_sided())) v.push_back(x);
+		REQUIRE(v.size() == 7u);
+		REQUIRE(v.front() == b);
+
+		v.clear();
+		for (auto x : loop::linspace(b, a, 7, loop::boundary::leftopen, interpolation::two_sided())) v.push_back(x);
+		REQUIRE(v.back() == a);
+	}
+}
+
+TEST_CASE("linear spaced, incremental with re-anchoring", "[linspace]")
+{
+	using Mode = loop::interpolation::reanchored<64>;
+	static_assert(Mode::K == 16, "");
+	static_assert(loop::interpolation::reanchored<0>::K == 1, "");
+
+	for (double b : { 6., -0.7, 1e6 })
+	{
+		const double a = 1, max = std::max(std::abs(a), std::abs(b));
+		const double ulp = std::nextafter(max, 2 * max) - max;
+		const int n = 100000;
+		std::vector<double> v, linear;
+
+		for (auto x : loop::linspace(a, b, n, loop::boundary::closed, Mode())) v.push_back(x);
+		for (auto x : loop::linspace(a, b, n)) linear.push_back(x);
+		REQUIRE(v.size() == linear.size());
+
+		for (int i = 0; i <= n; ++i)
+		{
+			if (i % Mode::K == 0) REQUIRE(v[i] == linear[i]);
+			if (std::abs(v[i] - linear[i]) > 64 * ulp) 
+			{
+				INFO("b = " << b << ", i = " << i);
+				REQUIRE(std::abs(v[i] - linear[i]) <= 64 * ulp);
+			}
+		}
+	}
+}
+
+TEST_CASE("integer linear spaced values rounded exactly", "[ilinspace]")
+{
+	using Vec = std::vector<int>;
+	using loop::boundary;
+	Vec v;
+
+	SECTION("ilinspace(0, 10, 4)") 
+	{
+		for (auto i : loop::ilinspace(0, 10, 4)) v.push_back(i);
+		REQUIRE(v == Vec({ 0, 3, 5, 8, 10 })); // 0 2.5 5 7.5 10
+	}
+
+	SECTION("ilinspace(10, 0, 4, boundary::open)") 
+	{
+		for (auto i : loop::ilinspace(10, 0, 4, boundary::open)) v.push_back(i);
+		REQUIRE(v == Vec({ 8, 5, 3 }));  // 7.5 5 2.5
+	}
+
+	SECTION("ilinspace(0, 1, 0) is empty") 
+	{
+		for (auto i : loop::ilinspace(0, 1, 0)) v.push_back(i);
+		REQUIRE(v.empty());
+	}
+
+	SECTION("all a, b, n and boundaries match floor(a + i*(b-a)/n + 1/2)") 
+	{
+		for (int a = -20; a <= 20; ++a)
+		for (int b = -20; b <= 20; ++b)
+		for (int n = 1; n <= 12; ++n)
+		for (auto type : { boundary::closed, boundary::rightopen, boundary::leftopen, boundary::open })
+		{
+			Vec expected;
+			int first = type == boundary::open || type == boundary::leftopen;
+			int last = n - (type == boundary::open || type == boundary::rightopen);
+			for (int i = first; i <= last; ++i) expected.push_back(int(std::floor(a + i * double(b - a) / n + 0.5)));
+
+			v.clear();
+			for (auto i : loop::ilinspace(a, b, n, type)) v.push_back(i);
+			if (v != expected)
+			{
+				INFO("ilinspace(" << a << ", " << b << ", " << n << ", " << int(type) << ")");
+				REQUIRE(v == expected);
+			}
+		}
+	}
+
+	SECTION("long grids, in fixed point and with the error term") 
+	{
+		// n(n+1) <= 2^(62 - bits(|b-a|)) is computed in fixed point
+		for (auto abn : { std::make_tuple(-7, 4095, 1000000), std::make_tuple(4095, -7, 999999), 
+			std::make_tuple(0, 1 << 30, 40000), std::make_tuple(0, 1 << 30, 100000), std::make_tuple(1 << 30, -3, 99999) })
+		{
+			long long a = std::get<0>(abn), b = std::get<1>(abn), n = std::get<2>(abn), i = 0;
+			for (auto x : loop::ilinspace(int(a), int(b), int(n)))
+			{
+				long long t = i++ * (b - a) + n / 2;
+				long long expected = a + t / n - (t % n < 0);
+				if (x != expected)
+				{
+					INFO("ilinspace(" << a << ", " << b << ", " << n << "), i = " << i - 1);
+					REQUIRE(x == expected);
+				}
+			}
+			REQUIRE(i == n + 1);
+		}
+	}
+
+	SECTION("long long, large unsigned spans and spans that overflow int") 
+	{
+		using Wide = std::vector<long long>;
+		auto values = [](auto r) { return Wide(r.begin(), r.end()); };
+
+		REQUIRE(values(loop::ilinspace(0LL, 10LL, 4)) == Wide({ 0, 3, 5, 8, 10 }));
+		REQUIRE(values(loop::ilinspace(0, 10, 4LL)) == Wide({ 0, 3, 5, 8, 10 }));
+		REQUIRE(values(loop::ilinspace(0u, 4000000000u, 4)) == Wide({ 0, 1000000000, 2000000000, 3000000000, 4000000000 }));
+		REQUIRE(values(loop::ilinspace(4000000000u, 0u, 4u)) == Wide({ 4000000000, 3000000000, 2000000000, 1000000000, 0 }));
+		REQUIRE(values(loop::ilinspace(-2000000000, 2000000000, 3)) == Wide({ -2000000000, -666666667, 666666667, 2000000000 }));
+		REQUIRE(values(loop::ilinspace(std::int16_t(-30000), std::int16_t(30000), 3)) == Wide({ -30000, -10000, 10000, 30000 }));
+#ifdef __SIZEOF_INT128__
+		const auto min = std::numeric_limits<long long>::min(), max = std::numeric_limits<long long>::max();
+		REQUIRE(values(loop::ilinspace(min, max, 2)) == Wide({ min, 0, max }));
+
+		std::vector<std::uint64_t> u;
+		for (auto x : loop::ilinspace(std::uint64_t(0), std::numeric_limits<std::uint64_t>::max(), 3)) u.push_back(x);
+		REQUIRE(u == std::vector<std::uint64_t>({ 0, 6148914691236517205u, 12297829382473034410u, 18446744073709551615u }));
+#endif
+	}
+
+	constexpr auto x = loop::to_array<3>(loop::ilinspace(0, 255, 2));
+	static_assert(x[1] == 128, "");
+}
+
+TEST_CASE("rasterized lines", "[ilinspace]")
+{
+	using Point = loop::point<int>;
+	using Vec = std::vector<Point>;
+	Vec v;
+
+	SECTION("line(0, 0, 4, 2)") 
+	{
+		for (auto p : loop::line(0, 0, 4, 2)) v.push_back(p);
+		REQUIRE(v == Vec({ {0, 0}, {1, 1}, {2, 1}, {3, 2}, {4, 2} }));
+	}
+
+	SECTION("line(0LL, 0LL, 4LL, 2LL), unsigned coordinates") 
+	{
+		std::vector<loop::point<long long>> wide;
+		for (auto p : loop::line(0LL, 0LL, 4LL, 2LL)) wide.push_back(p);
+		REQUIRE(wide == std::vector<loop::point<long long>>({ {0, 0}, {1, 1}, {2, 1}, {3, 2}, {4, 2} }));
+
+		std::vector<loop::point<unsigned>> u;
+		for (auto p : loop::line(4000000000u, 0u, 3999999996u, 2u)) u.push_back(p);
+		REQUIRE(u == std::vector<loop::point<unsigned>>({ {4000000000u, 0}, {3999999999u, 1}, {3999999998u, 1}, {3999999997u, 2}, {3999999996u, 2} }));
+	}
+
+	SECTION("a single point") 
+	{
+		for (auto p : loop::line(3, -1, 3, -1)) v.push_back(p);
+		REQUIRE(v == Vec({ {3, -1} }));
+	}
+
+	SECTION("all directions: ends, 8-connected steps, distance from the line") 
+	{
+		for (int x1 = -9; x1 <= 9; ++x1)
+		for (int y1 = -9; y1 <= 9; ++y1)
+		{
+			v.clear();
+			for (auto p : loop::line(0, 0, x1, y1)) v.push_back(p);
+
+			int n = std::max(std::abs(x1), std::abs(y1));
+			REQUIRE(v.size() == std::size_t(n + 1));
+			REQUIRE(v.front() == Point({ 0, 0 }));
+			REQUIRE(v.back() == Point({ x1, y1 }));
+
+			for (std::size_t i = 1; i < v.size(); ++i)
+			{
+				REQUIRE(std::max(std::abs(v[i].x - v[i-1].x), std::abs(v[i].y - v[i-1].y)) == 1);
+				// the minor coordinate is the nearest to the line
+				double t = double(i) / n;
+				REQUIRE(std::abs(v[i].x - t * x1) <= 0.5);
+				REQUIRE(std::abs(v[i].y - t * y1) <= 0.5);
+			}
+		}
+	}
+}
+
+TEST_CASE("log and geometric spaced values", "[logspace]")
+{
+	using Vec = std::vector<double>;
+	using loop::boundary;
+	Vec v, w;
+
+	// relative error of the incremental values, re-anchored every 16 values
+	auto near = [](double x, double y) { return std::abs(x - y) <= 64 * std::numeric_limits<double>::epsilon() * std::abs(y); };
+
+	SECTION("logspace(0, 3, 3) and boundaries like linspace()") 
+	{
+		for (auto x : loop::logspace(0., 3., 3)) v.push_back(x);
+		REQUIRE(v == Vec({ 1, 10, 100, 1000 }));
+
+		for (auto type : { boundary::closed, boundary::rightopen, boundary::leftopen, boundary::open })
+		for (int n : { 0, 1, 2, 17, 100 })
+		{
+			v.clear();
+			w.clear();
+			for (auto x : loop::logspace(-1., 2., n, type)) v.push_back(x);
+			for (auto x : loop::linspace(-1., 2., n, type)) w.push_back(std::pow(10., x));
+			REQUIRE(v.size() == w.size());
+			for (std::size_t i = 0; i < v.size(); ++i) REQUIRE(near(v[i], w[i]));
+		}
+	}
+
+	SECTION("geomspace with exact ends, also negative") 
+	{
+		for (auto x : loop::geomspace(1., 1000., 3)) v.push_back(x);
+		REQUIRE(v == Vec({ 1, 10, 100, 1000 }));
+
+		v.clear();
+		for (auto x : loop::geomspace(-0.3, -7e5, 1000)) v.push_back(x);
+		REQUIRE(v.size() == 1001u);
+		REQUIRE(v.front() == -0.3);
+		REQUIRE(v.back() == -7e5);
+		for (std::size_t i = 1; i < v.size(); ++i) 
+		{
+			REQUIRE(near(v[i], -0.3 * std::pow(7e5 / 0.3, i / 1000.)));
+		}
+	}
+
+	SECTION("copy() in blocks gives the same values up to rounding") 
+	{
+		for (auto type : { boundary::closed, boundary::rightopen, boundary::leftopen, boundary::open })
+		for (int n : { 1, 15, 16, 17, 1000 })
+		{
+			v.clear();
+			w.clear();
+			auto r = loop::geomspace(2., 5e3, n, type);
+			for (auto x : r) v.push_back(x);
+			loop::copy(r, std::back_inserter(w));
+			REQUIRE(v.size() == w.size());
+			for (std::size_t i = 0; i < v.size(); ++i) REQUIRE(near(w[i], v[i]));
+			if (type == boundary::closed) REQUIRE(w.back() == 5e3);
+			if (type == boundary::closed) REQUIRE(w.front() == 2.);
+		}
+
+		v.clear();
+		loop::copy(loop::linspace(0., 1., 4), std::back_inserter(v));
+		REQUIRE(v == Vec({ 0, 0.25, 0.5, 0.75, 1 }));
+	}
+}
+
+TEST_CASE("trigonometric values by rotation", "[cis]")
+{
+	const double pi = std::acos(-1.), eps = std::numeric_limits<double>::epsilon();
+
+	SECTION("cis() matches cos and sin over linspace()") 
+	{
+		for (auto type : { loop::boundary::closed, loop::boundary::rightopen, loop::boundary::open })
+		for (int n : { 0, 1, 7, 16, 1000 })
+		{
+			std::vector<std::complex<double>> z;
+			std::vector<double> theta;
+			for (auto c : loop::cis(0., 2 * pi, n, type)) z.push_back(c);
+			for (auto t : loop::linspace(0., 2 * pi, n, type)) theta.push_back(t);
+
+			REQUIRE(z.size() == theta.size());
+			for (std::size_t i = 0; i < z.size(); ++i)
+			{
+				REQUIRE(std::abs(z[i].real() - std::cos(theta[i])) <= 32 * eps);
+				REQUIRE(std::abs(z[i].imag() - std::sin(theta[i])) <= 32 * eps);
+			}
+		}
+	}
+
+	SECTION("random access for splitting") 
+	{
+		auto r = loop::cis(0., pi, 100);
+		auto first = r.begin(), last = r.end();
+
+		REQUIRE(std::distance(first, last) == 101);
+		REQUIRE(r.size() == 101u);
+		auto mid = first + 50;
+		REQUIRE(std::abs((*mid).real()) <= eps);
+		REQUIRE(std::abs(first[100].real() + 1) <= eps);
+		REQUIRE(std::abs(r[25].imag() - std::sin(pi / 4)) <= eps);
+		REQUIRE(*(last - 1) == *(first + 100));
+		REQUIRE(first < mid);
+		REQUIRE(std::distance(mid, last) == 51);
+	}
+
+	SECTION("Chebyshev nodes") 
+	{
+		std::vector<double> x;
+		for (auto xk : loop::chebyshev1(5)) x.push_back(xk);
+		REQUIRE(x.size() == 5u);
+		for (int k = 0; k < 5; ++k) REQUIRE(std::abs(x[k] - std::cos((2*k + 1) * pi / 10)) <= 4 * eps);
+
+		x.clear();
+		for (auto xk : loop::chebyshev2(64)) x.push_back(xk);
+		REQUIRE(x.size() == 65u);
+		REQUIRE(x.front() == 1.);
+		for (int k = 0; k <= 64; ++k) REQUIRE(std::abs(x[k] - std::cos(k * pi / 64)) <= 32 * eps);
+
+		x.clear();
+		for (auto xk : loop::chebyshev1(0u)) x.push_back(xk);
+		for (auto xk : loop::chebyshev2<float>(0)) x.push_back(xk);
+		REQUIRE(x.empty());
+	}
+}
+
+TEST_CASE("polynomial values by forward differences", "[polyspace]")
+{
+	auto horner = [](const std::vector<double>& c, double x)
+		{
+			double p = 0;
+			for (auto k = c.size(); k-- > 0; ) p = p * x + c[k];
+			return p;
+		};
+
+	SECTION("polyspace({ 1, 0, 2 }, linspace(0, 1, 4))") 
+	{
+		std::vector<double> v;
+		for (auto p : loop::polyspace({ 1., 0., 2. }, loop::linspace(0., 1., 4))) v.push_back(p);
+		REQUIRE(v == std::vector<double>({ 1, 1.125, 1.5, 2.125, 3 }));
+	}
+
+	SECTION("degree 0 to 4 along long grids") 
+	{
+		const std::vector<double> c{ 0.5, -1.25, 3.0, 0.75, -0.125 };
+		for (auto type : { loop::boundary::closed, loop::boundary::rightopen, loop::boundary::open })
+		for (int n : { 0, 1, 5, 31, 32, 33, 10000 })
+		{
+			std::vector<double> x, p0, p2, p4;
+			for (auto xi : loop::linspace(-2., 3., n, type)) x.push_back(xi);
+			for (auto p : loop::polyspace(std::array<double, 1>{{ c[0] }}, loop::linspace(-2., 3., n, type))) p0.push_back(p);
+			for (auto p : loop::polyspace({ c[0], c[1], c[2] }, loop::linspace(-2., 3., n, type))) p2.push_back(p);
+			for (auto p : loop::polyspace({ c[0], c[1], c[2], c[3], c[4] }, loop::linspace(-2., 3., n, type))) p4.push_back(p);
+
+			REQUIRE(p0.size() == x.size());
+			REQUIRE(p2.size() == x.size());
+			REQUIRE(p4.size() == x.size());
+			for (std::size_t i = 0; i < x.size(); ++i)
+			{
+				REQUIRE(p0[i] == c[0]);
+				REQUIRE(std::abs(p2[i] - horner({ c[0], c[1], c[2] }, x[i])) <= 1e-12);
+				REQUIRE(std::abs(p4[i] - horner(c, x[i])) <= 1e-11);
+			}
+		}
+	}
+
+	SECTION("random access for splitting") 
+	{
+		auto r = loop::polyspace({ 1., 2., 3. }, loop::linspace(0., 10., 1000));
+		auto first = r.begin();
+		
+		REQUIRE(r.size() == 1001u);
+		REQUIRE(std::distance(first, r.end()) == 1001);
+		REQUIRE(std::abs(first[500] - (1 + 2*5. + 3*25.)) <= 1e-12);
+		REQUIRE(std::abs(*(r.end() - 1) - (1 + 20. + 300.)) <= 1e-12);
+
+		auto it = first + 999;
+		++it;
+		REQUIRE(std::abs(*it - r[1000]) <= 1e-12);
+	}
+}
+
+TEST_CASE("bins of linspace values in O(1)", "[bucketize]")
+{
+	using loop::boundary;
+
+	// the position of x by std::upper_bound on the values
+	auto upper_bound = [](const std::vector<double>& v, double x, bool descending)
+		{
+			return std::size_t(descending 
+				? std::distance(v.begin(), std::upper_bound(v.begin(), v.end(), x, std::greater<double>()))
+				: std::distance(v.begin(), std::upper_bound(v.begin(), v.end(), x)));
+		};
+
+	SECTION("index_of(x) of linspace(0, 1, 4)") 
+	{
+		auto r = loop::linspace(0., 1., 4);
+		REQUIRE(r.index_of(-1.) == 0);
+		REQUIRE(r.index_of(0.) == 1);
+		REQUIRE(r.index_of(0.3) == 2);
+		REQUIRE(r.index_of(0.75) == 4);
+		REQUIRE(r.index_of(1.) == 5);
+		REQUIRE(r.index_of(7.) == 5);
+		REQUIRE(r.index_of(std::nan("")) == 0);
+	}
+
+	SECTION("values, their neighbours and random samples, all boundaries and modes") 
+	{
+		std::mt19937 random(1);
+		for (auto type : { boundary::closed, boundary::rightopen, boundary::leftopen, boundary::open })
+		for (int n : { 0, 1, 2, 3, 7, 100, 1000, 10000 })
+		for (auto ab : { std::make_pair(-1., 1.), std::make_pair(3., -2.), std::make_pair(0.1, 0.7), std::make_pair(1e6, 1e6 + 1.) })
+		{
+			auto linear = loop::linspace(ab.first, ab.second, n, type);
+			auto two_sided = loop::linspace(ab.first, ab.second, n, type, loop::interpolation::two_sided{});
+			std::vector<double> v1(linear.begin(), linear.end()), v2(two_sided.begin(), two_sided.end());
+
+			std::uniform_real_distribution<double> sample(
+				std::min(ab.first, ab.second) - 0.5, std::max(ab.first, ab.second) + 0.5);
+			std::vector<double> x{ -INFINITY, INFINITY };
+			for (int k = 0; k < 1000; ++k) x.push_back(sample(random));
+			for (auto& v : { v1, v2 })
+			{
+				for (auto e : v)
+				{
+					x.push_back(e);
+					x.push_back(std::nextafter(e, INFINITY));
+					x.push_back(std::nextafter(e, -INFINITY));
+				}
+			}
+
+			bool descending = ab.first > ab.second;
+			std::vector<std::size_t> expected1, expected2, index1, index2;
+			for (auto xk : x)
+			{
+				expected1.push_back(upper_bound(v1, xk, descending));
+				expected2.push_back(upper_bound(v2, xk, descending));
+				index1.push_back(linear.index_of(xk));
+				index2.push_back(two_sided.index_of(xk));
+			}
+			std::vector<int> bins1(x.size()), bins2(x.size());
+			loop::bucketize(linear, x.begin(), x.end(), bins1.begin());
+			two_sided.bucketize(x.begin(), x.end(), bins2.begin());
+
+			INFO("n = " << n << ", a = " << ab.first << ", b = " << ab.second);
+			REQUIRE(index1 == expected1);
+			REQUIRE(index2 == expected2);
+			REQUIRE(std::vector<std::size_t>(bins1.begin(), bins1.end()) == expected1);
+			REQUIRE(std::vector<std::size_t>(bins2.begin(), bins2.end()) == expected2);
+		}
+	}
+
+	SECTION("a == b") 
+	{
+		auto r = loop::linspace(2., 2., 3);
+		REQUIRE(r.index_of(1.) == 0);
+		REQUIRE(r.index_of(2.) == 4);
+		REQUIRE(r.index_of(3.) == 4);
+	}
+
+	SECTION("float and unsigned n") 
+	{
+		auto r = loop::linspace(0.f, 1.f, 10u, boundary::open);
+		std::vector<float> v(r.begin(), r.end());
+		for (auto x : loop::linspace(-0.5f, 1.5f, 997u))
+		{
+			auto expected = std::distance(v.begin(), std::upper_bound(v.begin(), v.end(), x));
+			REQUIRE(r.index_of(x) == unsigned(expected));
+		}
+	}
+}
@@ -1,101 +1,807 @@
 #ifndef LOOP_RANGE_H
 #define LOOP_RANGE_H
 
+#include <array>
+#include <algorithm>
 #include <cmath>
+#include <complex>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <iterator>
+#include <stdexcept>
+#include <utility>
+
+// setup code out of line keeps loops over ranges as short as handwritten
+// ones, cold code leaves them to a separate section
+#if defined(__GNUC__)
+#define LOOP_NOINLINE __attribute__((noinline))
+#define LOOP_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define LOOP_NOINLINE __declspec(noinline)
+#define LOOP_COLD __declspec(noinline)
+#else
+#define LOOP_NOINLINE
+#define LOOP_COLD
+#endif
 
 namespace loop {
 
 // ---[ integral ranges ]----------------------------------
 
+// compile-time step size for range() and generate(), e.g. range(0, n, step<4>())
+template <int Step>
+using step = std::integral_constant<int, Step>;
+
 namespace detail {
 
 template <typename T, typename N, typename Increment>
 class RangeGenerator		
 {
 public: 
-	RangeGenerator(T start, N n, Increment step) 
+	constexpr RangeGenerator(T start, N n, Increment step) 
 	: start_(start), n_(n), step_(step)
 	{
 	}
 	
-	class iterator : public std::iterator<std::forward_iterator_tag, T>
+	class iterator
 	{
 	public:
-		iterator() : n_(0) {}
-		iterator(T v, N n, Increment s) : v_(v), n_(n), s_(s) {}
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = T*;
+		using reference         = T&;
 
-		bool operator==(const iterator& rhs) const { return n_ == rhs.n_; }
-		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+		constexpr iterator() : n_(0) {}
+		constexpr iterator(T v, N n, Increment s) : v_(v), n_(n), s_(s) {}
 
-		auto& operator++()      { v_ += s_; --n_; return *this; }
-		auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
-		auto  operator*() const { return v_; }
+		constexpr bool operator==(const iterator& rhs) const { return n_ == rhs.n_; }
+		constexpr bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+		constexpr auto& operator++()      { v_ += s_; --n_; return *this; }
+		constexpr auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		constexpr auto  operator*() const { return v_; }
 	private:
 		T v_;
 		N n_;
 		Increment s_;	
 	};
 
-	iterator begin() const { return { start_, n_, step_ }; }
-	iterator end()   const { return {}; }
+	constexpr iterator begin() const { return { start_, n_, step_ }; }
+	constexpr iterator end()   const { return { start_, 0, step_ }; }
 private: 
 	T start_;
 	N n_;
 	Increment step_;
 };
 
+// integral types, with __int128 also where std::is_integral does not know it
+template <typename T>
+struct is_integer : std::is_integral<T> {};
+
+template <typename T>
+struct make_unsigned : std::make_unsigned<T> {};
+
+template <typename T>
+struct make_signed : std::make_signed<T> {};
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+
+template <> struct is_integer<int128>  : std::true_type {};
+template <> struct is_integer<uint128> : std::true_type {};
+template <> struct make_unsigned<int128>  { using type = uint128; };
+template <> struct make_unsigned<uint128> { using type = uint128; };
+template <> struct make_signed<int128>  { using type = int128; };
+template <> struct make_signed<uint128> { using type = int128; };
+#endif
+
+template <typename T>
+using make_unsigned_t = typename make_unsigned<T>::type;
+
+template <typename T>
+using make_signed_t = typename make_signed<T>::type;
+
+// type of exact sums over ranges of T: twice as wide, 64 bit types
+// where the compiler provides __int128
+template <typename T, typename = void>
+struct sum_type { using type = T; };
+
+template <typename T>
+struct sum_type<T, std::enable_if_t<(sizeof(T) < sizeof(std::int64_t))>>
+{
+	using type = std::conditional_t<std::is_signed<T>::value, std::int64_t, std::uint64_t>;
+};
+
+#ifdef __SIZEOF_INT128__
+template <typename T>
+struct sum_type<T, std::enable_if_t<sizeof(T) == sizeof(std::int64_t)>>
+{
+	using type = std::conditional_t<std::is_signed<T>::value, int128, uint128>;
+};
+#endif
+
+template <typename T>
+using sum_t = typename sum_type<T>::type;
+
+// modular arithmetic of unsigned N for the intersection of ranges
+template <typename N>
+constexpr N gcd(N a, N b)
+{
+	while (b != 0)
+	{
+		N r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+// a*b mod m for a, b < m, by doubling without overflow
+template <typename N>
+constexpr N mul_mod(N a, N b, N m)
+{
+	N r = 0;
+	for (; b != 0; b >>= 1)
+	{
+		if (b & 1) r = r >= m - a ? r - (m - a) : r + a;
+		a = a >= m - a ? a - (m - a) : a + a;
+	}
+	return r;
+}
+
+// x with a*x = 1 mod m for coprime a and m: extended Euclid modulo m
+template <typename N>
+constexpr N inverse_mod(N a, N m)
+{
+	N r0 = m, r1 = a % m, x0 = 0, x1 = 1 % m;
+	while (r1 != 0)
+	{
+		N q = r0 / r1, r = r0 - q * r1, p = mul_mod(q % m, x1, m);
+		N x = x0 >= p ? x0 - p : x0 + (m - p);
+		r0 = r1; r1 = r;
+		x0 = x1; x1 = x;
+	}
+	return x0;
+}
+
+template <typename W, typename T, typename N, typename Step>
+constexpr auto arithmetic(T start, N i, Step step, bool empty);
+
+// signed runtime step of reversed and intersected ranges: twice as wide 
+// as W, so all step magnitudes below 2^bits keep their direction. 64 bit 
+// W without __int128 and 128 bit W have no wider type.
+template <typename W>
+using wide_step_t = make_signed_t<sum_t<make_signed_t<W>>>;
+
+// step of a reversed range, wide for runtime steps
+template <typename W, typename Step>
+constexpr auto negated_step(Step step)
+{
+	using S = wide_step_t<W>;
+	using U = make_unsigned_t<S>;
+	return S(U(0) - U(S(step)));
+}
+
+template <typename W, typename T, T Step>
+constexpr auto negated_step(std::integral_constant<T, Step>) { return std::integral_constant<T, -Step>{}; }
+
+// Set difference of ranges: the values before and after the common 
+// values, and the gaps between consecutive common values. The gaps are 
+// ranges of the same size, one every period values of the range.
+template <typename Range>
+struct range_difference
+{
+	constexpr range_difference(Range first, Range second, Range values, std::size_t from, std::size_t period, std::size_t gaps)
+	: first(first), second(second), values_(values), from_(from), period_(period), gaps_(gaps)
+	{
+	}
+
+	Range first, second;
+
+	constexpr std::size_t gaps() const { return gaps_; }
+	constexpr Range gap(std::size_t k) const { return values_.drop(from_ + k * period_ + 1).first(period_ - 1); }
+	constexpr std::size_t size() const { return first.size() + second.size() + gaps_ * (period_ - 1); }
+private:
+	Range values_;
+	std::size_t from_, period_, gaps_;
+};
+
+// a range with a runtime step as returned by setup code out of line: 
+// first == last if it is empty, with step 0, or flagged to wrap, with 
+// its end position in end, so that a loop tests a single condition
+template <typename W, typename Step>
+struct arithmetic_bounds
+{
+	W first, last;
+	Step step;
+	W end;
+};
+
+// Arithmetic sequence of range(): a single iteration variable p runs
+// from first to last by step, *it yields p.
+// Step is W or a std::integral_constant known at compile time.
+// With Wrap, a range may be flagged to wrap around: p then runs modulo
+// 2^bits and a done flag tells the end from the begin of a full cycle.
+// The flag is loop invariant, so compilers unswitch the loop on it: 
+// ranges with a runtime step build flagged ranges in cold code only.
+// A value lies at its distance from first in steps, so positions, 
+// searches and sums take O(1).
+template <typename T, typename W, typename Step = W, bool Wrap = false>
+class IntegralRangeGenerator
+{
+	using U = make_unsigned_t<W>;
+	using N = std::common_type_t<U, unsigned>; // no promotion to int
+	using Count = std::common_type_t<N, std::uint64_t>;
+public:
+	constexpr IntegralRangeGenerator(W first, W last, Step step, bool wrap = false)
+	: first_(first), last_(last), step_(step), wrap_(wrap)
+	{
+	}
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = T*;
+		using reference         = T;
+
+		constexpr iterator() : p_(0), s_(), last_(0), wrap_(false), done_(false) {}
+		constexpr iterator(W p, Step s, W last, bool wrap, bool done) 
+		: p_(p), s_(s), last_(last), wrap_(wrap), done_(done) 
+		{
+		}
+
+		constexpr bool operator==(const iterator& rhs) const 
+		{ 
+			return Wrap && wrap_ ? p_ == rhs.p_ && done_ == rhs.done_ : p_ == rhs.p_; 
+		}
+		constexpr bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+		constexpr bool operator< (const iterator& rhs) const { return remaining() > rhs.remaining(); }
+		constexpr bool operator> (const iterator& rhs) const { return rhs < *this; }
+		constexpr bool operator<=(const iterator& rhs) const { return !(rhs < *this); }
+		constexpr bool operator>=(const iterator& rhs) const { return !(*this < rhs); }
+
+		constexpr auto& operator++()
+		{
+			if (Wrap && wrap_)
+			{
+				p_ = W(U(p_) + U(s_));
+				done_ = p_ == last_;
+			}
+			else p_ += s_;
+			return *this;
+		}
+		constexpr auto& operator--()      { return *this += -1; }
+		constexpr auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		constexpr auto  operator--(int)   { auto tmp(*this); --*this; return tmp; }
+
+		// forward onto the end position of a full cycle sets the done flag
+		constexpr auto& operator+=(difference_type k)
+		{
+			p_ = W(N(p_) + N(k) * N(s_));
+			done_ = p_ == last_ && (k > 0 || (k == 0 && done_));
+			return *this;
+		}
+		constexpr auto& operator-=(difference_type k) { return *this += -k; }
+		constexpr auto  operator+ (difference_type k) const { auto tmp(*this); return tmp += k; }
+		constexpr auto  operator- (difference_type k) const { auto tmp(*this); return tmp -= k; }
+		friend constexpr auto operator+(difference_type k, const iterator& it) { return it + k; }
+		constexpr difference_type operator-(const iterator& rhs) const { return difference_type(rhs.remaining() - remaining()); }
+
+		constexpr auto  operator*() const { return T(p_); }
+		constexpr auto  operator[](difference_type k) const { return *(*this + k); }
+
+		// std::find, std::count, std::lower_bound and std::upper_bound in O(1), 
+		// found by argument-dependent lookup. Descending ranges are ordered 
+		// as by std::greater<>().
+		friend constexpr iterator find(iterator first, iterator last, const T& value) { return first.search(last, W(value), 0); }
+		friend constexpr iterator lower_bound(iterator first, iterator last, const T& value) { return first.search(last, W(value), 1); }
+		friend constexpr iterator upper_bound(iterator first, iterator last, const T& value) { return first.search(last, W(value), 2); }
+		friend constexpr difference_type count(iterator first, iterator last, const T& value) 
+		{ 
+			return first.search(last, W(value), 0) != last ? 1 : 0; 
+		}
+	private:
+		template <typename, typename, typename, bool> friend class IntegralRangeGenerator;
+
+		constexpr N magnitude() const { return s_ > 0 ? N(s_) : N(N(0) - N(s_)); }
+
+		// distance from p to v in the direction of the step: values behind p 
+		// wrap around to distances beyond any value of the range
+		constexpr N distance(W v) const { return s_ > 0 ? N(N(v) - N(p_)) : N(N(p_) - N(v)); }
+		constexpr bool behind(W v) const { return s_ > 0 ? v < p_ : p_ < v; }
+
+		constexpr bool at_end() const { return p_ == last_ && (!(Wrap && wrap_) || done_); }
+		constexpr W last_value() const { return W(N(last_) - N(s_)); }
+
+		// the number of values up to the end, modulo 2^bits for all 2^bits 
+		// values of a 64 bit type
+		constexpr Count remaining() const { return at_end() ? 0 : Count(distance(last_value()) / magnitude()) + 1; }
+
+		constexpr iterator advanced(N k) const { return { W(N(p_) + k * N(s_)), s_, last_, wrap_, false }; }
+
+		// the position of v (mode 0), of the first value not before v (1) 
+		// or after v (2) within [*this, last), else last
+		constexpr iterator search(const iterator& last, W v, int mode) const
+		{
+			if (*this == last) return last;
+			const N m = magnitude(), d = distance(v), d_last = distance(W(N(last.p_) - N(s_)));
+
+			if (mode == 0) return d % m == 0 && d <= d_last ? advanced(d / m) : last;
+			if (behind(v)) return *this;
+			if (mode == 1) return d <= d_last ? advanced(d / m + (d % m != 0)) : last;
+			return d / m < d_last / m ? advanced(d / m + 1) : last;
+		}
+
+		W p_;
+		Step s_;
+		W last_;
+		bool wrap_, done_;
+	};
+
+	constexpr iterator begin() const { return { first_, step_, last_, wrap_, false }; }
+	constexpr iterator end()   const { return { last_, step_, last_, wrap_, true }; }
+
+	// the range as arithmetic_bounds, and back out of line for the rare 
+	// ranges with first == last
+	constexpr arithmetic_bounds<W, Step> bounds() const
+	{
+		const bool none = empty();
+		return { first_, none || wrap_ ? first_ : last_, none ? Step(0) : step_, last_ };
+	}
+	static LOOP_COLD constexpr IntegralRangeGenerator rare(arithmetic_bounds<W, Step> r)
+	{
+		return r.step == 0 ? IntegralRangeGenerator{ r.first, r.last, Step(1) } : IntegralRangeGenerator{ r.first, r.end, r.step, true };
+	}
+
+	// the number of values, modulo 2^64 for all 2^64 values of a 64 bit type
+	constexpr bool empty() const { return begin() == end(); }
+	constexpr std::size_t size() const { return std::size_t(begin().remaining()); }
+
+	constexpr T front() const { return T(first_); }
+	constexpr T back()  const { return T(begin().last_value()); }
+
+	// the k-th value first + k*step
+	constexpr T operator[](std::size_t k) const { return begin()[difference_type(k)]; }
+
+	constexpr bool contains(T value) const { return find(value) != end(); }
+	constexpr std::size_t count(T value) const { return contains(value) ? 1 : 0; }
+	constexpr iterator find(T value) const { return begin().search(end(), W(value), 0); }
+
+	// like std::lower_bound and std::upper_bound, for descending ranges 
+	// with std::greater<>()
+	constexpr iterator lower_bound(T value) const { return begin().search(end(), W(value), 1); }
+	constexpr iterator upper_bound(T value) const { return begin().search(end(), W(value), 2); }
+
+	// size()*first + step*i*(i+1)/2 for the last index i, modulo 2^bits 
+	// of R like std::accumulate in R, exact in the default sum_t<T>
+	template <typename R = sum_t<T>>
+	constexpr R sum() const
+	{
+		static_assert(is_integer<R>::value, "integral type required");
+		using UR = std::common_type_t<make_unsigned_t<R>, unsigned>;
+		if (empty()) return 0;
+
+		const N i = last_index();
+		const UR triangle = i % 2 ? UR(i) * UR(i / 2 + 1) : UR(i / 2) * UR(i + 1);
+		return R(UR(UR(i) + 1) * UR(first_) + UR(step_) * triangle);
+	}
+
+	// Range algebra in O(1): the parts are ranges again, in the direction 
+	// of this range. first(k) and drop(k) split before the k-th value.
+	constexpr auto first(std::size_t k) const
+	{
+		return k == 0 || empty() ? none() : slice(0, Count(k - 1) < Count(last_index()) ? N(k - 1) : last_index());
+	}
+	constexpr auto drop(std::size_t k) const
+	{
+		return empty() || Count(k) > Count(last_index()) ? none() : slice(N(k), last_index());
+	}
+	constexpr auto split_at(std::size_t k) const { return std::make_pair(first(k), drop(k)); }
+
+	// the i-th of count consecutive parts, whose sizes differ by at most one
+	constexpr auto shard(std::size_t i, std::size_t count) const
+	{
+		if (empty() || i >= count) return none();
+
+		// size() = q*count + r, without overflow for all 2^bits values
+		Count q = Count(last_index()) / count, r = Count(last_index()) % count + 1;
+		if (r == count)
+		{
+			++q;
+			r = 0;
+		}
+
+		const Count from = i * q + (i < r ? i : r), size = q + (i < r);
+		return size == 0 ? none() : slice(N(from), N(from + size - 1));
+	}
+
+	// the values in reverse order, by the negated step
+	constexpr auto reverse() const
+	{
+		return arithmetic<W>(back(), empty() ? N(0) : last_index(), negated_step<W>(step_), empty());
+	}
+
+	// the common values, stepping by the lcm of the steps
+	template <typename T2, typename Step2, bool Wrap2>
+	constexpr auto intersection(const IntegralRangeGenerator<T2, W, Step2, Wrap2>& other) const
+	{
+		using S = wide_step_t<W>;
+		W x = first_;
+		N step = 1, i = 0;
+		if (!common(other, x, step, i)) return arithmetic<W>(T(first_), N(0), S(1), true);
+
+		// without a wider step type, common values farther apart than the 
+		// signed step holds yield the first of them
+		if (sizeof(S) == sizeof(W) && step > N(U(-1) >> 1)) i = 0;
+
+		const S s = i ? S(step) : S(1);
+		return step_ > 0 
+			? arithmetic<W>(T(x), i, s, false) 
+			: arithmetic<W>(T(W(N(x) + i * step)), i, S(S(0) - s), false);
+	}
+
+	// the values of this range not in other: before, between and after 
+	// the common values, see range_difference
+	template <typename T2, typename Step2, bool Wrap2>
+	constexpr auto difference(const IntegralRangeGenerator<T2, W, Step2, Wrap2>& other) const
+	{
+		using Difference = range_difference<decltype(none())>;
+		W x = first_;
+		N step = 1, i = 0;
+		if (!common(other, x, step, i)) return Difference(drop(0), none(), drop(0), 0, 1, 0);
+
+		// indices of the lowest and the highest common value
+		const auto it = begin();
+		const N m = it.magnitude(), low = it.distance(x) / m, high = it.distance(W(N(x) + i * step)) / m;
+		const N from = step_ > 0 ? low : high, to = step_ > 0 ? high : low, period = i ? step / m : N(1);
+		return Difference(
+			from == 0 ? none() : slice(0, from - 1),
+			to == last_index() ? none() : slice(to + 1, last_index()),
+			drop(0), std::size_t(from), std::size_t(period), period == 1 ? 0 : std::size_t((to - from) / period));
+	}
+private:
+	template <typename, typename, typename, bool> friend class IntegralRangeGenerator;
+	using difference_type = typename iterator::difference_type;
+
+	constexpr N last_index() const { return begin().distance(begin().last_value()) / begin().magnitude(); }
+	constexpr W low()  const { return step_ > 0 ? first_ : W(back()); }
+	constexpr W high() const { return step_ > 0 ? W(back()) : first_; }
+
+	// the values from index i to j as a range, or none
+	constexpr auto slice(N i, N j) const { return arithmetic<W>(T(W(N(first_) + i * N(step_))), N(j - i), step_, false); }
+	constexpr auto none() const { return arithmetic<W>(T(first_), N(0), step_, true); }
+
+	// the common values x, x + step, ..., x + i*step in ascending order, 
+	// or false if there are none: one congruence per range, solved by the
+	// Chinese remainder theorem, gives x; the step is the lcm of the steps
+	template <typename T2, typename Step2, bool Wrap2>
+	constexpr bool common(const IntegralRangeGenerator<T2, W, Step2, Wrap2>& other, W& x, N& step, N& i) const
+	{
+		if (empty() || other.empty()) return false;
+
+		const W la = low(), lb = other.low();
+		const W lo = la < lb ? lb : la, hi = high() < other.high() ? high() : other.high();
+		if (hi < lo) return false;
+
+		// x = la + ma*k = lb mod mb: k = (lb - la)/g * (ma/g)^-1 mod mb/g
+		const N ma = begin().magnitude(), mb = other.begin().magnitude(), g = gcd(ma, mb), mg = mb / g;
+		const N d = lb < la ? (mb - (N(la) - N(lb)) % mb) % mb : (N(lb) - N(la)) % mb;
+		if (d % g != 0) return false;
+
+		const N k = mul_mod(d / g % mg, inverse_mod(ma / g % mg, mg), mg);
+		if (k > (N(hi) - N(la)) / ma) return false;
+
+		x = W(N(la) + ma * k);
+		step = ma;
+		i = 0; // a single value if the lcm exceeds the domain
+		if (ma / g <= N(-1) / mb)
+		{
+			step = ma / g * mb;
+			if (x < lo)
+			{
+				const N skip = N(lo) - N(x), j = skip / step + (skip % step != 0);
+				if (j > (N(hi) - N(x)) / step) return false;
+				x = W(N(x) + j * step);
+			}
+			i = (N(hi) - N(x)) / step;
+		}
+		else if (x < lo) return false;
+		return true;
+	}
+
+	W first_, last_;
+	Step step_;
+	bool wrap_;
+};
+
+// value type of runtime and compile-time steps
+template <typename Increment>
+struct step_value { using type = Increment; };
+
+template <typename T, T Step>
+struct step_value<std::integral_constant<T, Step>> { using type = T; };
+
+template <typename Increment>
+using step_value_t = typename step_value<Increment>::type;
+
+// step of the iteration variable: a zero step yields no or a single value.
+// A signed step of an unsigned variable stays signed: it adds modulo 2^bits 
+// all the same and keeps the direction of the range.
+template <typename W, typename Increment>
+constexpr auto iteration_step(Increment step) 
+{ 
+	using S = std::conditional_t<(Increment(-1) < Increment(0)), make_signed_t<W>, W>;
+	return step != 0 ? S(step) : S(1); 
+}
+
+template <typename W, typename T, T Step>
+constexpr auto iteration_step(std::integral_constant<T, Step>) { return std::integral_constant<T, Step != 0 ? Step : 1>{}; }
+
+// the values start, start + step, ..., start + i*step, or none if empty.
+// The end position start + (i+1)*step wraps around if the range covers
+// the full domain of W or, for signed W, overflows: the range is then
+// flagged to wrap, which only a counter as wide as T can need. Values 
+// are counted in their own type, so unsigned indices stay vectorizable.
+template <typename W, typename T, typename N, typename Step>
+constexpr auto arithmetic(T start, N i, Step step, bool empty)
+{
+	using U = std::common_type_t<make_unsigned_t<W>, unsigned>; // no promotion to int
+	constexpr bool may_wrap = sizeof(W) == sizeof(T);
+	constexpr bool is_signed = W(-1) < W(0);
+	constexpr W max = W(make_unsigned_t<W>(-1) >> is_signed), min = is_signed ? W(-max - 1) : W(0);
+
+	W first = start;
+	if (empty) return IntegralRangeGenerator<T, W, Step, may_wrap>{ first, first, step };
+
+	W last = W(U(first) + U(i) * U(step));
+	bool wrap = may_wrap && (is_signed ? (step > 0 ? last > max - step : last < min - step) : W(U(last) + U(step)) == first);
+
+	return IntegralRangeGenerator<T, W, Step, may_wrap>{ first, W(U(last) + U(step)), step, wrap };
+}
+
+// range(a, b, step<1>()) or step<-1>(): p ends at b, or at a if empty
+template <typename Start, typename End, typename T, T Step>
+constexpr auto unit_range(Start start, End end, std::integral_constant<T, Step> step)
+{
+	using Domain = std::common_type_t<Start, End, T>;
+	using W = Domain;
+	static_assert(is_integer<Domain>::value, "integral type required");
+
+	Domain a = start, b = end;
+	return IntegralRangeGenerator<Domain, W, decltype(step)>{ a, (b < a) == (Step < 0) ? b : a, step };
+}
+
 } // end namespace detail
 
 template <typename Start, typename N, typename Increment>
-auto generate(Start start, N n, Increment step) 
+constexpr auto generate(Start start, N n, Increment step) 
 {
 	static_assert(std::is_integral<N>::value, "integral type required");
 	return detail::RangeGenerator<Start, N, Increment>{ start, n, step };
 }
 
-template <typename Start, typename End, typename Increment>
-auto range(Start start, End end, Increment step, bool with_end = false) 
+namespace detail {
+
+// range(a, b, step, with_end) over W, with_end a bool or std::false_type
+template <typename W, typename T, typename Increment, typename WithEnd>
+constexpr auto arithmetic_range(T a, T b, Increment step, WithEnd with_end)
 {
-	using Domain = std::common_type_t<Start, End, Increment>;
-	using N = std::common_type_t<Domain, std::size_t>;
-	
-	static_assert(std::is_integral<Domain>::value, "integral type required");
+	using N = make_unsigned_t<W>;
 
-	Domain a = start, b = end;	
-	N n = a == b && with_end;
+	bool empty = a == b ? !with_end : step == 0 || (b < a) != (step < 0);
+	N i = 0; // index of the last value
 	
-	if (step != 0 && (b < a) == (step < 0))
+	if (!empty && a != b)
 	{
-		n = b < a ? a - b : b - a;
-		Increment abs_step = step > 0 ? step : -step;
+		N distance = b < a ? N(a) - N(b) : N(b) - N(a);
+		N abs_step = step < 0 ? N(0) - N(step) : N(step);
 
-		if (abs_step != 1) n /= abs_step;
-		if (with_end) ++n;
-		else if (Domain(a + n*step) != b) ++n;
+		i = (distance - !with_end) / abs_step;
 	}
 	
-	return generate(a, n, step);
+	return arithmetic<W>(a, i, iteration_step<W>(step), empty);
+}
+
+// setup of a range with a runtime step, without an argument for 
+// range(a, b, step)
+template <typename W, typename T, typename Increment>
+LOOP_NOINLINE constexpr auto runtime_bounds(T a, T b, Increment step, bool with_end)
+{
+	return arithmetic_range<W>(a, b, step, with_end).bounds();
+}
+
+template <typename W, typename T, typename Increment>
+LOOP_NOINLINE constexpr auto runtime_bounds(T a, T b, Increment step)
+{
+	return arithmetic_range<W>(a, b, step, std::false_type{}).bounds();
+}
+
+template <typename W, typename T, typename Increment>
+constexpr auto runtime_bounds(T a, T b, Increment step, std::false_type) { return runtime_bounds<W>(a, b, step); }
+
+// a runtime step costs a division: it runs out of line, and loops test 
+// first != last before they start, as for a handwritten loop. Empty 
+// ranges and ranges flagged to wrap are built in cold code.
+template <typename W, typename T, typename Increment, typename WithEnd>
+constexpr auto stepped_range(T a, T b, Increment step, WithEnd with_end)
+{
+	using Generator = decltype(arithmetic_range<W>(a, b, step, with_end));
+	auto r = runtime_bounds<W>(a, b, step, with_end);
+	return r.first != r.last ? Generator{ r.first, r.last, r.step } : Generator::rare(r);
+}
+
+template <typename W, typename T, typename S, S Step, typename WithEnd>
+constexpr auto stepped_range(T a, T b, std::integral_constant<S, Step> step, WithEnd with_end)
+{
+	return arithmetic_range<W>(a, b, step, with_end);
 }
 
+template <typename Start, typename End, typename Increment, typename WithEnd>
+constexpr auto integral_range(Start start, End end, Increment step, WithEnd with_end)
+{
+	using Domain = std::common_type_t<Start, End, step_value_t<Increment>>;
+	using W = Domain;
+	static_assert(is_integer<Domain>::value, "integral type required");
+
+	Domain a = start, b = end;
+	return stepped_range<W>(a, b, step, with_end);
+}
+
+} // end namespace detail
+
+template <typename Start, typename End, typename Increment>
+constexpr auto range(Start start, End end, Increment step, bool with_end) 
+{
+	return detail::integral_range(start, end, step, with_end);
+}
+
+template <typename Start, typename End, typename Increment>
+constexpr auto range(Start start, End end, Increment step) { return detail::integral_range(start, end, step, std::false_type{}); }
+
+template <typename Start, typename End, typename T>
+constexpr auto range(Start start, End end, std::integral_constant<T, 1> step) { return detail::unit_range(start, end, step); }
+
+template <typename Start, typename End, typename T>
+constexpr auto range(Start start, End end, std::integral_constant<T, -1> step) { return detail::unit_range(start, end, step); }
+
 template <typename Start, typename End>
-auto range(Start start, End end) { return range(start, end, 1); }
+constexpr auto range(Start start, End end) { return range(start, end, step<1>()); }
 
 template <typename N>
-auto range(N n) { return range(N{}, n); }
+constexpr auto range(N n) { return range(N{}, n); }
 
 template <typename N>
-auto countdown(N n) { return range((n ? n-1 : 0), 0, -1, n != 0); }
+constexpr auto countdown(N n)
+{
+	using Domain = std::common_type_t<N, int>;
+	static_assert(detail::is_integer<Domain>::value, "integral type required");
+
+	// unsigned values narrower than 64 bit are counted down in 64 bit: the 
+	// loop ends at -1 instead of wrapping around below 0, and vectorizes
+	using W = std::conditional_t<std::is_unsigned<Domain>::value && (sizeof(Domain) < sizeof(std::uint64_t)),
+		std::uint64_t, Domain>;
+
+	W first = n > 0 ? W(n) : 0;
+	return detail::IntegralRangeGenerator<Domain, W, step<-1>>{ W(first - 1), W(-1), {} };
+}
+
+// ---[ compile-time unrolled ranges ]----------------------------------
+
+namespace detail {
+
+// number of values of range(a, b, s, with_end)
+constexpr long long static_count(long long a, long long b, long long s, bool with_end)
+{
+	return a == b ? with_end
+		: s == 0 || (b < a) != (s < 0) ? 0
+		: ((b < a ? a - b : b - a) - !with_end) / (s < 0 ? -s : s) + 1;
+}
+
+template <int Begin, int Step, typename Indices>
+struct StaticRange;
+
+template <int Begin, int Step, std::size_t... K>
+struct StaticRange<Begin, Step, std::index_sequence<K...>>
+{
+	static constexpr std::size_t size() { return sizeof...(K); }
+
+	// f(std::integral_constant<int, Begin + k*Step>{}) for k = 0, 1, ..., size()-1
+	template <typename F>
+	void operator()(F&& f) const
+	{
+		using expand = int[];
+		(void)expand{ 0, (void(f(std::integral_constant<int, int(Begin + (long long)K * Step)>{})), 0)... };
+	}
+};
+
+} // end namespace detail
+
+// static_range<Begin, End, Step, WithEnd>()(f) calls f once per value of 
+// range(Begin, End, Step, WithEnd), unrolled at compile time.
+// f receives the value as std::integral_constant<int, I>, e.g. for std::get<I>.
+template <int Begin, int End, int Step = 1, bool WithEnd = false>
+constexpr auto static_range()
+{
+	return detail::StaticRange<Begin, Step, 
+		std::make_index_sequence<std::size_t(detail::static_count(Begin, End, Step, WithEnd))>>{};
+}
+
+template <int End>
+constexpr auto static_range() { return static_range<0, End>(); }
 
 // ---[ non-integral, interpolated ranges ]----------------------------------
 
+// Formulas for the values x_i = a + i*(b-a)/n of linspace() with their error
+// bounds: dx = (b-a)*(1/n) is rounded thrice, u is the unit roundoff (2^-53 for double).
+namespace interpolation {
+
+// a + i*dx (default): |error| <= (|a| + 5i|dx|) u, b is missed by up to (|a| + 5|b-a|) u
+struct linear
+{
+	template <typename D, typename S>
+	static constexpr D value(D, D a, D, D dx, S i, S) { return a + i * dx; }
+	template <typename D, typename N, typename S>
+	static constexpr D next(D x, D, D, N, S) { return x; }
+};
+
+// fma(i, dx, a), a single rounding: |error| <= (|a| + 4i|dx|) u, b is missed by up to (|b| + 3|b-a|) u
+struct fma
+{
+	template <typename D, typename S>
+	static D value(D, D a, D, D dx, S i, S) { return std::fma(i, dx, a); }
+	template <typename D, typename N, typename S>
+	static constexpr D next(D x, D, D, N, S) { return x; }
+};
+
+// a + i*dx for the first half, b - (n-i)*dx for the second half: 
+// a and b exact, |error| <= (max(|a|,|b|) + 3n|dx|) u
+struct two_sided
+{
+	template <typename D, typename S>
+	static constexpr D value(D, D a, D b, D dx, S i, S n) { return 2 * i <= n ? a + i * dx : b - (n - i) * dx; }
+	template <typename D, typename N, typename S>
+	static constexpr D next(D x, D, D, N, S) { return x; }
+};
+
+// x += dx, a single addition per value without conversion of i, but a 
+// chain of roundings: |error| <= (i+3)(|a| + |b|) u, b is missed by up to (n+3)(|a| + |b|) u
+struct incremental
+{
+	template <typename D, typename S>
+	static constexpr D value(D x, D, D, D, S, S) { return x; }
+	template <typename D, typename N, typename S>
+	static constexpr D next(D x, D, D dx, N, S) { return x + dx; }
+};
+
+// x += dx, restarting from a + i*dx every K steps: K is the largest power of two 
+// with 4(K-1) <= MaxUlps, so x stays within MaxUlps ulp(max(|a|,|b|)) of linear
+template <unsigned MaxUlps = 64>
+struct reanchored
+{
+	static constexpr unsigned period(unsigned k = 1) { return 4 * (2*k - 1) <= MaxUlps ? period(2*k) : k; }
+	static constexpr unsigned K = period();
+
+	template <typename D, typename S>
+	static constexpr D value(D x, D, D, D, S, S) { return x; }
+	template <typename D, typename N, typename S>
+	static constexpr D next(D x, D a, D dx, N i, S si) { return i % K == 0 ? a + si * dx : x + dx; }
+};
+
+} // end namespace interpolation
+
 namespace detail {
 
-template <typename Domain, typename N>
+template <typename Domain, typename N, typename Mode = interpolation::linear>
 class LinearGenerator
 {
-	static auto scalar(N n)
+	static constexpr auto scalar(N n)
 	{
 		using std::abs;
 		using ScalarType = decltype(abs(Domain{}));
@@ -104,62 +810,891 @@ class LinearGenerator
 	
 public:
 
-	LinearGenerator(Domain a, Domain b, N n, N first, N last)
-	: a_(a), dx_((b-a)*(1/scalar(n))), first_(first), last_(last)
+	constexpr LinearGenerator(Domain a, Domain b, N n, N first, N last)
+	: a_(a), b_(b), dx_((b-a)*(1/scalar(n))), n_(n), first_(first), last_(last)
 	{
 	}
 
-	class iterator : public std::iterator<std::forward_iterator_tag, Domain>
+	class iterator
 	{
 	public:
-		iterator() : i_(0) {}
-		iterator(Domain a, Domain dx, N i)
-		: a_(a), dx_(dx), i_(i) 
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = Domain;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = Domain*;
+		using reference         = Domain&;
+
+		constexpr iterator() : a_(), b_(), dx_(), x_(), n_(0), i_(0) {}
+		constexpr iterator(Domain a, Domain b, Domain dx, N n, N i)
+		: a_(a), b_(b), dx_(dx), x_(a + scalar(i) * dx), n_(n), i_(i) 
 		{
 		}
 
-		bool operator==(const iterator& rhs) const { return i_ == rhs.i_; }
-		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+		constexpr bool operator==(const iterator& rhs) const { return i_ == rhs.i_; }
+		constexpr bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
 
-		auto& operator++()      { ++i_; return *this; }
-		auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
-		auto  operator*() const { return a_ + scalar(i_) * dx_; }
+		constexpr auto& operator++()      { ++i_; x_ = Mode::next(x_, a_, dx_, i_, scalar(i_)); return *this; }
+		constexpr auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		constexpr auto  operator*() const { return Mode::value(x_, a_, b_, dx_, scalar(i_), scalar(n_)); }
 	private:
-		Domain a_, dx_;
-		N i_;	
+		Domain a_, b_, dx_, x_;
+		N n_, i_;	
 	};
 
-	iterator begin() const { return { a_, dx_, first_ }; }
-	iterator end()   const { return { a_, dx_, last_ + 1 }; }
-private:
-	Domain a_, dx_;
-	N first_, last_;
-};
+	constexpr iterator begin() const { return { a_, b_, dx_, n_, first_ }; }
+	constexpr iterator end()   const { return { a_, b_, dx_, n_, last_ + 1 }; }
 
-} // end namespace detail
+	// grid parameters: values a + i*dx, i = first...last of 0...n
+	constexpr Domain a()  const { return a_; }
+	constexpr Domain dx() const { return dx_; }
+	constexpr N n()       const { return n_; }
+	constexpr N first()   const { return first_; }
+	constexpr N last()    const { return last_; }
 
-enum class boundary { closed, rightopen, leftopen, open };
+	constexpr std::size_t size() const { return last_ < first_ ? 0 : std::size_t(last_ - first_ + 1); }
 
-template <typename Start, typename End, typename N>
-auto linspace(Start a, End b, N n, boundary type = boundary::closed)
-{
-	using Domain = decltype(a + (b - a)); 
-	static_assert(!std::is_integral<Domain>::value, "use non-integral [a,b]");
-	static_assert(std::is_integral<N>::value,       "use integral n");
+	// the k-th value, for the incremental modes a + i*dx
+	constexpr Domain operator[](std::size_t k) const { return edge(scalar(first_ + N(k))); }
 
-	if (n < 1) 
-	{
-		n = 1;
-		type = boundary::open;
+	// the values from the k-th on, the incremental modes restart at a + i*dx
+	constexpr LinearGenerator drop(std::size_t k) const 
+	{ 
+		return { a_, b_, n_, N(first_ + N(k < size() ? k : size())), last_ }; 
 	}
-	
-	bool start_at_one = type == boundary::open || type == boundary::leftopen;
-	bool end_before_n = type == boundary::open || type == boundary::rightopen;
-    
+
+	// the number of values x has reached in their order, ascending or descending, 
+	// like std::upper_bound on the values: 0 below the first value and for NaN, 
+	// size() at or beyond the last value. O(1): the estimate (x-a)/dx is 
+	// corrected against the values, which is exact while it is off by at most 
+	// one step, i.e. for |a/dx| and n below about 2^50 (double). 
+	// The incremental modes are binned by a + i*dx.
+	constexpr N index_of(Domain x) const 
+	{ 
+		return degenerate() ? locate_degenerate(x) : locate(x, 1 / dx_, dx_ < 0 ? -1 : 1); 
+	}
+
+	// out[k] = index_of(x[k]) for the samples in [first, last), vectorizes
+	template <typename InputIt, typename OutputIt>
+	OutputIt bucketize(InputIt first, InputIt last, OutputIt out) const
+	{
+		const LinearGenerator edges(*this); // not aliased by out
+		if (degenerate())
+		{
+			for (; first != last; ++first) *out++ = edges.locate_degenerate(*first);
+			return out;
+		}
+		const Domain inv_dx = 1 / dx_, sign = dx_ < 0 ? -1 : 1;
+		for (; first != last; ++first) *out++ = edges.locate(*first, inv_dx, sign);
+		return out;
+	}
+private:
+	template <typename S>
+	constexpr Domain edge(S i) const { return Mode::value(a_ + i * dx_, a_, b_, dx_, i, scalar(n_)); }
+
+	constexpr bool degenerate() const { return last_ < first_ || dx_ == 0; }
+	constexpr N locate_degenerate(Domain x) const { return last_ < first_ || !(a_ <= x) ? 0 : last_ - first_ + 1; }
+
+	// branchless: i = clamp((x-a)/dx), +1 for each of the values i, i+1 x 
+	// reached; counted in Domain, which vectorizes, sign*x orders 
+	// descending values
+	constexpr N locate(Domain x, Domain inv_dx, Domain sign) const
+	{
+		using S = decltype(scalar(0));
+		// hi + 0.5: the conversion of a clamped t is not folded into a branch
+		S t = (x - a_) * inv_dx, lo = scalar(first_), hi = scalar(last_) + S(0.5);
+		t = t > lo ? t : lo;
+		t = t < hi ? t : hi;
+		S i = scalar(static_cast<N>(t)), sx = sign * x, size = scalar(last_ - first_ + 1);
+		S k = i - lo 
+			+ (sign * edge(i)     <= sx ? S(1) : S(0))
+			+ (sign * edge(i + 1) <= sx ? S(1) : S(0));
+		return static_cast<N>(k < size ? k : size);
+	}
+
+	Domain a_, b_, dx_;
+	N n_, first_, last_;
+};
+
+// linspace<N, Type>(a, b): count and boundary known at compile time, 
+// the generator holds a and dx only
+template <typename Domain, int N, int First, int Last>
+class StaticLinearGenerator
+{
+	static constexpr auto scalar(int n)
+	{
+		using std::abs;
+		using ScalarType = decltype(abs(Domain{}));
+		return static_cast<ScalarType>(n);
+	}
+
+public:
+	constexpr StaticLinearGenerator(Domain a, Domain b)
+	: a_(a), dx_((b-a)*(1/scalar(N)))
+	{
+	}
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = Domain;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = Domain*;
+		using reference         = Domain&;
+
+		constexpr iterator() : a_(), dx_(), i_(0) {}
+		constexpr iterator(Domain a, Domain dx, int i)
+		: a_(a), dx_(dx), i_(i) 
+		{
+		}
+
+		constexpr bool operator==(const iterator& rhs) const { return i_ == rhs.i_; }
+		constexpr bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+		constexpr auto& operator++()      { ++i_; return *this; }
+		constexpr auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		constexpr auto  operator*() const { return a_ + scalar(i_) * dx_; }
+	private:
+		Domain a_, dx_;
+		int i_;	
+	};
+
+	static constexpr std::size_t size() { return Last < First ? 0 : Last - First + 1; }
+
+	constexpr iterator begin() const { return { a_, dx_, First }; }
+	constexpr iterator end()   const { return { a_, dx_, Last + 1 }; }
+private:
+	Domain a_, dx_;
+};
+
+} // end namespace detail
+
+enum class boundary { closed, rightopen, leftopen, open };
+
+template <typename Start, typename End, typename N, typename Mode = interpolation::linear>
+constexpr auto linspace(Start a, End b, N n, boundary type = boundary::closed, Mode = {})
+{
+	using Domain = decltype(a + (b - a)); 
+	static_assert(!std::is_integral<Domain>::value, "use non-integral [a,b] or ilinspace()");
+	static_assert(std::is_integral<N>::value,       "use integral n");
+
+	if (n < 1) 
+	{
+		n = 1;
+		type = boundary::open;
+	}
+	
+	bool start_at_one = type == boundary::open || type == boundary::leftopen;
+	bool end_before_n = type == boundary::open || type == boundary::rightopen;
+    
 	N first = start_at_one;
 	N last  = n - end_before_n;
 	
-	return detail::LinearGenerator<Domain, N>(a, b, n, first, last);
+	return detail::LinearGenerator<Domain, N, Mode>(a, b, n, first, last);
+}
+
+// N intervals known at compile time: linspace<N>(a, b), linspace<N, boundary::open>(a, b)
+template <int N, boundary Type = boundary::closed, typename Start, typename End>
+constexpr auto linspace(Start a, End b)
+{
+	using Domain = decltype(a + (b - a)); 
+	static_assert(!std::is_integral<Domain>::value, "use non-integral [a,b] or ilinspace()");
+
+	constexpr bool empty = N < 1;
+	constexpr int first = empty || Type == boundary::open || Type == boundary::leftopen;
+	constexpr int last  = empty ? 0 : N - (Type == boundary::open || Type == boundary::rightopen);
+
+	return detail::StaticLinearGenerator<Domain, empty ? 1 : N, first, last>(a, b);
+}
+
+// ---[ binning ]----------------------------------
+
+// bins of samples for the values of linspace() as edges: 
+// out[k] = edges.index_of(x[k]), bin 0 below the first edge
+template <typename Domain, typename N, typename Mode, typename InputIt, typename OutputIt>
+OutputIt bucketize(const detail::LinearGenerator<Domain, N, Mode>& edges, InputIt first, InputIt last, OutputIt out)
+{
+	return edges.bucketize(first, last, out);
+}
+
+// ---[ geometric ranges ]----------------------------------
+
+namespace detail {
+
+// first and last index of n intervals with given boundary, empty if first > last
+template <typename N>
+constexpr auto boundary_indices(N& n, boundary type)
+{
+	if (n < 1) 
+	{
+		n = 1;
+		type = boundary::open;
+	}
+	bool start_at_one = type == boundary::open || type == boundary::leftopen;
+	bool end_before_n = type == boundary::open || type == boundary::rightopen;
+
+	return std::make_pair(N(start_at_one), N(n - end_before_n));
+}
+
+// x_i = sign * 10^(l0 + i*dl), or exactly a and b for i = 0 and n (geomspace)
+template <typename Domain, typename N>
+struct GeometricSequence
+{
+	Domain sign, l0, dl, a, b;
+	N n;
+	bool exact_ends;
+
+	Domain operator()(N i) const
+	{
+		if (exact_ends && i == 0) return a;
+		if (exact_ends && i == n) return b;
+		return sign * std::pow(Domain(10), l0 + static_cast<Domain>(i) * dl);
+	}
+};
+
+// x *= 10^dl, re-anchored to the exact value every K-th and the last value
+template <typename Domain, typename N>
+class GeometricGenerator
+{
+public:
+	static constexpr N K = 16;
+
+	GeometricGenerator(GeometricSequence<Domain, N> x, N first, N last)
+	: x_(x), ratio_(std::pow(Domain(10), x.dl)), first_(first), last_(last)
+	{
+	}
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = Domain;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = Domain*;
+		using reference         = Domain&;
+
+		iterator() : x_(), ratio_(), v_(), i_(0) {}
+		iterator(GeometricSequence<Domain, N> x, Domain ratio, N i) 
+		: x_(x), ratio_(ratio), v_(x(i)), i_(i) 
+		{
+		}
+		iterator(N i) : x_(), ratio_(), v_(), i_(i) {}
+
+		bool operator==(const iterator& rhs) const { return i_ == rhs.i_; }
+		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+		auto& operator++()
+		{
+			++i_;
+			v_ = i_ % K == 0 || i_ == x_.n ? x_(i_) : v_ * ratio_;
+			return *this;
+		}
+		auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		auto  operator*() const { return v_; }
+	private:
+		GeometricSequence<Domain, N> x_;
+		Domain ratio_, v_;
+		N i_;
+	};
+
+	iterator begin() const { return { x_, ratio_, first_ }; }
+	iterator end()   const { return { N(last_ + 1) }; }
+
+	// writes the values in blocks of K: the anchor value times a table 
+	// of 10^(j*dl), which vectorizes; equal to the iterator up to rounding
+	template <typename OutputIt>
+	OutputIt copy(OutputIt out) const
+	{
+		Domain powers[K];
+		for (N j = 0; j < K; ++j) powers[j] = std::pow(Domain(10), static_cast<Domain>(j) * x_.dl);
+
+		N i = first_, last = last_;
+		bool exact_last = x_.exact_ends && last == x_.n && i <= last;
+		
+		if (x_.exact_ends && i == 0 && i <= last) *out++ = x_(i++);
+		if (exact_last) --last;
+
+		while (i <= last)
+		{
+			N anchor = i - i % K, end = std::min<N>(anchor + K - 1, last);
+			Domain x = x_.sign * std::pow(Domain(10), x_.l0 + static_cast<Domain>(anchor) * x_.dl);
+
+			for (; i <= end; ++i) *out++ = x * powers[i - anchor];
+		}
+		if (exact_last) *out++ = x_(x_.n);
+		return out;
+	}
+private:
+	GeometricSequence<Domain, N> x_;
+	Domain ratio_;
+	N first_, last_;
+};
+
+template <typename Domain, typename N>
+constexpr N GeometricGenerator<Domain, N>::K;
+
+} // end namespace detail
+
+// n+1 values 10^x for x in linspace(a, b, n), e.g. frequencies logspace(1, 4, 30)
+template <typename Start, typename End, typename N>
+auto logspace(Start a, End b, N n, boundary type = boundary::closed)
+{
+	using Domain = decltype(a + (b - a)); 
+	static_assert(std::is_floating_point<Domain>::value, "use floating-point [a,b]");
+	static_assert(std::is_integral<N>::value,            "use integral n");
+
+	auto indices = detail::boundary_indices(n, type);
+	detail::GeometricSequence<Domain, N> x{ 1, Domain(a), (b - a) / static_cast<Domain>(n), 0, 0, n, false };
+
+	return detail::GeometricGenerator<Domain, N>(x, indices.first, indices.second);
+}
+
+// n+1 values from a to b (both exact) with constant ratio, a and b of equal sign and nonzero
+template <typename Start, typename End, typename N>
+auto geomspace(Start a, End b, N n, boundary type = boundary::closed)
+{
+	using Domain = decltype(a + (b - a)); 
+	static_assert(std::is_floating_point<Domain>::value, "use floating-point [a,b]");
+	static_assert(std::is_integral<N>::value,            "use integral n");
+
+	using std::abs;
+	using std::log10;
+	auto indices = detail::boundary_indices(n, type);
+	Domain l0 = log10(abs(Domain(a))), l1 = log10(abs(Domain(b)));
+	detail::GeometricSequence<Domain, N> x{ a < 0 ? Domain(-1) : Domain(1), l0, (l1 - l0) / static_cast<Domain>(n), Domain(a), Domain(b), n, true };
+
+	return detail::GeometricGenerator<Domain, N>(x, indices.first, indices.second);
+}
+
+// writes the values of a range to out
+template <typename Range, typename OutputIt>
+OutputIt copy(const Range& r, OutputIt out)
+{
+	for (auto x : r) *out++ = x;
+	return out;
+}
+
+template <typename Domain, typename N, typename OutputIt>
+OutputIt copy(const detail::GeometricGenerator<Domain, N>& r, OutputIt out) { return r.copy(out); }
+
+// ---[ trigonometric ranges ]----------------------------------
+
+namespace detail {
+
+// z_i = (cos θ_i, sin θ_i) for θ_i = θ0 + i*dθ by rotation z *= (cos dθ, sin dθ),
+// resynchronized to std::polar() every K-th value and on random access.
+// With Real, *it yields cos θ_i only.
+template <typename Domain, typename N, bool Real = false>
+class CisGenerator
+{
+	using Complex = std::complex<Domain>;
+	using Value = std::conditional_t<Real, Domain, Complex>;
+
+	static constexpr Value value(Complex z, std::true_type)  { return z.real(); }
+	static constexpr Value value(Complex z, std::false_type) { return z; }
+
+public:
+	static constexpr N K = 16;
+
+	CisGenerator(Domain theta0, Domain dtheta, N first, N last)
+	: theta0_(theta0), dtheta_(dtheta), first_(first), last_(last)
+	{
+	}
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = Value;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = Value*;
+		using reference         = Value;
+
+		iterator() : theta0_(), dtheta_(), w_(), z_(), i_(0) {}
+		iterator(Domain theta0, Domain dtheta, N i)
+		: theta0_(theta0), dtheta_(dtheta), w_(std::polar(Domain(1), dtheta)), z_(exact(i)), i_(i)
+		{
+		}
+
+		bool operator==(const iterator& rhs) const { return i_ == rhs.i_; }
+		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+		bool operator< (const iterator& rhs) const { return i_ < rhs.i_; }
+		bool operator> (const iterator& rhs) const { return rhs < *this; }
+		bool operator<=(const iterator& rhs) const { return !(rhs < *this); }
+		bool operator>=(const iterator& rhs) const { return !(*this < rhs); }
+
+		auto& operator++()
+		{
+			++i_;
+			z_ = i_ % K == 0 ? exact(i_) : rotate(z_, w_);
+			return *this;
+		}
+		auto& operator--()      { --i_; z_ = exact(i_); return *this; }
+		auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		auto  operator--(int)   { auto tmp(*this); --*this; return tmp; }
+
+		auto& operator+=(difference_type k) { i_ = N(i_ + k); z_ = exact(i_); return *this; }
+		auto& operator-=(difference_type k) { return *this += -k; }
+		auto  operator+ (difference_type k) const { auto tmp(*this); return tmp += k; }
+		auto  operator- (difference_type k) const { auto tmp(*this); return tmp -= k; }
+		friend auto operator+(difference_type k, const iterator& it) { return it + k; }
+		difference_type operator-(const iterator& rhs) const { return difference_type(i_) - difference_type(rhs.i_); }
+
+		auto  operator*() const { return value(z_, std::integral_constant<bool, Real>{}); }
+		auto  operator[](difference_type k) const { return *(*this + k); }
+	private:
+		Complex exact(N i) const { return std::polar(Domain(1), theta0_ + static_cast<Domain>(i) * dtheta_); }
+
+		// z*w without the checks of std::complex for infinite and NaN parts
+		static Complex rotate(Complex z, Complex w)
+		{
+			return { z.real() * w.real() - z.imag() * w.imag(), z.real() * w.imag() + z.imag() * w.real() };
+		}
+
+		Domain theta0_, dtheta_;
+		Complex w_, z_;
+		N i_;
+	};
+
+	iterator begin() const { return { theta0_, dtheta_, first_ }; }
+	iterator end()   const { return { theta0_, dtheta_, N(last_ + 1) }; }
+
+	std::size_t size() const { return last_ < first_ ? 0 : std::size_t(last_ - first_ + 1); }
+	Value operator[](std::size_t k) const { return begin()[k]; }
+private:
+	Domain theta0_, dtheta_;
+	N first_, last_;
+};
+
+template <typename Domain, typename N, bool Real>
+constexpr N CisGenerator<Domain, N, Real>::K;
+
+} // end namespace detail
+
+// (cos θ, sin θ) as std::complex for θ in linspace(a, b, n), e.g. cis(0., 2*pi, n, boundary::rightopen)
+template <typename Start, typename End, typename N>
+auto cis(Start a, End b, N n, boundary type = boundary::closed)
+{
+	using Domain = decltype(a + (b - a)); 
+	static_assert(std::is_floating_point<Domain>::value, "use floating-point [a,b]");
+	static_assert(std::is_integral<N>::value,            "use integral n");
+
+	auto indices = detail::boundary_indices(n, type);
+	return detail::CisGenerator<Domain, N>(a, (b - a) / static_cast<Domain>(n), indices.first, indices.second);
+}
+
+// Chebyshev nodes of the first kind, the n roots cos((2k+1)π/(2n)) of T_n, k = 0...n-1, descending
+template <typename Domain = double, typename N>
+auto chebyshev1(N n)
+{
+	static_assert(std::is_integral<N>::value, "use integral n");
+	const Domain pi = std::acos(Domain(-1));
+	N m = n > 0 ? n : 1;
+	
+	return detail::CisGenerator<Domain, N, true>(pi / (2 * static_cast<Domain>(m)), pi / static_cast<Domain>(m), n > 0 ? 0 : 1, n > 0 ? n - 1 : 0);
+}
+
+// Chebyshev nodes of the second kind, the n+1 extrema cos(kπ/n) of T_n, k = 0...n, descending
+template <typename Domain = double, typename N>
+auto chebyshev2(N n)
+{
+	static_assert(std::is_integral<N>::value, "use integral n");
+	const Domain pi = std::acos(Domain(-1));
+	N m = n > 0 ? n : 1;
+
+	return detail::CisGenerator<Domain, N, true>(0, pi / static_cast<Domain>(m), n > 0 ? 0 : 1, n > 0 ? n : 0);
+}
+
+// ---[ polynomial ranges ]----------------------------------
+
+namespace detail {
+
+// p(x_i) = c[0] + c[1]*x_i + ... + c[D]*x_i^D for x_i = a + i*dx by a table of forward 
+// differences, d additions per value. Seeded in O(D^2) every K-th value to bound 
+// the error and on random access.
+template <typename Value, typename Domain, std::size_t M, typename N>
+class PolynomialGenerator
+{
+	static constexpr std::size_t D = M - 1;
+	using Coefficients = std::array<Value, M>;
+
+public:
+	static constexpr N K = 32;
+
+	PolynomialGenerator(const Coefficients& c, Domain a, Domain dx, N first, N last)
+	: c_(c), a_(a), dx_(dx), first_(first), last_(last)
+	{
+	}
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type        = Value;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = Value*;
+		using reference         = Value;
+
+		iterator() : c_(), a_(), dx_(), d_(), i_(0) {}
+		iterator(const Coefficients& c, Domain a, Domain dx, N i)
+		: c_(c), a_(a), dx_(dx), d_(), i_(i)
+		{
+			seed();
+		}
+
+		bool operator==(const iterator& rhs) const { return i_ == rhs.i_; }
+		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+		bool operator< (const iterator& rhs) const { return i_ < rhs.i_; }
+		bool operator> (const iterator& rhs) const { return rhs < *this; }
+		bool operator<=(const iterator& rhs) const { return !(rhs < *this); }
+		bool operator>=(const iterator& rhs) const { return !(*this < rhs); }
+
+		auto& operator++()
+		{
+			++i_;
+			if (i_ % K == 0) seed();
+			else step(std::make_index_sequence<D>{});
+			return *this;
+		}
+		auto& operator--()      { --i_; seed(); return *this; }
+		auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		auto  operator--(int)   { auto tmp(*this); --*this; return tmp; }
+
+		auto& operator+=(difference_type k) { i_ = N(i_ + k); seed(); return *this; }
+		auto& operator-=(difference_type k) { return *this += -k; }
+		auto  operator+ (difference_type k) const { auto tmp(*this); return tmp += k; }
+		auto  operator- (difference_type k) const { auto tmp(*this); return tmp -= k; }
+		friend auto operator+(difference_type k, const iterator& it) { return it + k; }
+		difference_type operator-(const iterator& rhs) const { return difference_type(i_) - difference_type(rhs.i_); }
+
+		auto  operator*() const { return d_[0]; }
+		auto  operator[](difference_type k) const { return *(*this + k); }
+	private:
+		// d_[k] += d_[k+1] with constant indices: keeps the table in registers
+		template <std::size_t... k>
+		void step(std::index_sequence<k...>)
+		{
+			using expand = int[];
+			(void)expand{ 0, (d_[k] += d_[k + 1], 0)... };
+		}
+
+		// q(t) = p(x_i + t*dx) = sum b[j] t^j by a Taylor shift, then without cancellation 
+		// the k-th difference sum b[j] k! S(j,k), S: Stirling numbers of the second kind
+		void seed()
+		{
+			Coefficients b = c_;
+			Domain x = a_ + static_cast<Domain>(i_) * dx_, h = 1;
+
+			for (std::size_t k = 0; k < D; ++k)
+			{
+				for (std::size_t j = D; j-- > k; ) b[j] += b[j + 1] * x;
+			}
+
+			std::array<Domain, M> t{}; // t[k] = k! S(j,k)
+			Coefficients d{};
+			t[0] = 1;
+			for (std::size_t j = 0; j <= D; ++j)
+			{
+				if (j > 0)
+				{
+					h *= dx_;
+					b[j] *= h;
+					for (std::size_t k = j; k > 0; --k) t[k] = static_cast<Domain>(k) * (t[k] + t[k - 1]);
+					t[0] = 0;
+				}
+				for (std::size_t k = 0; k <= j; ++k) d[k] += b[j] * t[k];
+			}
+			d_ = d;
+		}
+
+		Coefficients c_;
+		Domain a_, dx_;
+		Coefficients d_; // d_[k]: k-th forward difference at x_i
+		N i_;
+	};
+
+	iterator begin() const { return { c_, a_, dx_, first_ }; }
+	iterator end()   const { return { c_, a_, dx_, N(last_ + 1) }; }
+
+	std::size_t size() const { return last_ < first_ ? 0 : std::size_t(last_ - first_ + 1); }
+	Value operator[](std::size_t k) const { return begin()[k]; }
+private:
+	Coefficients c_;
+	Domain a_, dx_;
+	N first_, last_;
+};
+
+template <typename Value, typename Domain, std::size_t M, typename N>
+constexpr N PolynomialGenerator<Value, Domain, M, N>::K;
+
+} // end namespace detail
+
+// p(x) = c[0] + c[1]*x + ... for the values x of a linspace(), e.g.
+// polyspace({ 1., 0., 2. }, linspace(0., 1., n)) for 1 + 2x^2
+template <typename C, std::size_t M, typename Domain, typename N, typename Mode>
+auto polyspace(const std::array<C, M>& c, const detail::LinearGenerator<Domain, N, Mode>& grid)
+{
+	static_assert(M > 0, "use at least one coefficient");
+	using Value = std::decay_t<decltype(c[0] * grid.a() + c[0])>;
+
+	std::array<Value, M> v{};
+	for (std::size_t k = 0; k < M; ++k) v[k] = c[k];
+	return detail::PolynomialGenerator<Value, Domain, M, N>(v, grid.a(), grid.dx(), grid.first(), grid.last());
+}
+
+template <typename C, std::size_t M, typename Domain, typename N, typename Mode>
+auto polyspace(const C (&c)[M], const detail::LinearGenerator<Domain, N, Mode>& grid)
+{
+	std::array<C, M> a{};
+	for (std::size_t k = 0; k < M; ++k) a[k] = c[k];
+	return polyspace(a, grid);
+}
+
+// ---[ integral interpolated ranges ]----------------------------------
+
+template <typename T>
+struct point
+{
+	T x, y;
+
+	constexpr bool operator==(const point& rhs) const { return x == rhs.x && y == rhs.y; }
+	constexpr bool operator!=(const point& rhs) const { return !(*this == rhs); }
+};
+
+namespace detail {
+
+// floor(t / n) for n > 0
+template <typename W>
+constexpr W floor_div(W t, W n) { return t / n - (t % n < 0); }
+
+template <typename W>
+constexpr W ceil_div(W t, W n) { return floor_div(t + n - 1, n); }
+
+// x = a + floor((i*d + n/2) / n), the value a + i*d/n rounded half up, advanced 
+// from i to i+1 by adds only. If exact, in k bit fixed point, which vectorizes:
+// X = (x - min(a, a+d)) * 2^k + fraction, rounded up by less than 1/n in total
+// if n(n+1) <= 2^k, with k = 62 - bits(|d|) and |d| < 2^31. 
+// Else by an error term: i*d + n/2 = n*(x-a) + e, 0 <= e < n.
+template <typename W>
+class DDA
+{
+	static constexpr int bits(std::uint64_t v) { return v ? 1 + bits(v >> 1) : 0; }
+
+	static constexpr bool small(W v) { return v > -(W(1) << 31) && v < (W(1) << 31); }
+
+public:
+	constexpr DDA() 
+	: fixed_(false), k_(0), X_(0), Q_(0), base_(0), x_(0), e_(0), q_(0), r_(0), n_(1) 
+	{
+	}
+
+	constexpr DDA(W a, W d, W n, W i) 
+	: fixed_(false), k_(0), X_(0), Q_(0), 
+	  base_(d < 0 ? a + d : a), x_(0), e_(0), q_(floor_div(d, n)), r_(d - q_ * n), n_(n)
+	{
+		if (small(d) && small(n))
+		{
+			const auto abs_d = std::uint64_t(d < 0 ? -d : d), n64 = std::uint64_t(n);
+			k_ = 62 - bits(abs_d);
+			fixed_ = n64 * (n64 + 1) <= (std::uint64_t(1) << k_);
+		}
+		if (fixed_)
+		{
+			const std::int64_t one = std::int64_t(1) << k_, half = one / 2, d64 = std::int64_t(d), n64 = std::int64_t(n);
+			std::int64_t fraction = n64 % 2 ? half - half / n64 : half; // ceil(floor(n/2) * 2^k / n)
+
+			Q_ = std::uint64_t(ceil_div(d64 * one, n64));
+			X_ = std::uint64_t(d64 < 0 ? -d64 * one : 0) + std::uint64_t(fraction) + std::uint64_t(i) * Q_;
+		}
+		else
+		{
+			W t = i * d + n / 2;
+			W f = floor_div(t, n);
+			x_ = a + f;
+			e_ = t - f * n;
+		}
+	}
+
+	constexpr void step()
+	{
+		if (fixed_) 
+		{
+			X_ += Q_;
+		}
+		else
+		{
+			W carry = e_ >= n_ - r_;
+			x_ += q_ + carry;
+			e_ += r_ - carry * n_;
+		}
+	}
+
+	constexpr W value() const { return fixed_ ? base_ + W(X_ >> k_) : x_; }
+private:
+	bool fixed_;
+	int k_;
+	std::uint64_t X_, Q_;
+	W base_, x_, e_, q_, r_, n_;
+};
+
+// counter of DDA: signed, and wide enough for b - a and i*d + n/2 with 
+// i <= n, 64 bit or twice as wide where the compiler provides __int128
+template <typename T, typename N>
+using dda_counter_t = std::conditional_t<(8 * sizeof(T) + 8 * sizeof(N) - std::is_signed<N>::value <= 63),
+	std::int64_t, make_signed_t<sum_t<std::int64_t>>>;
+
+template <typename T, typename W>
+class IntegerLinearGenerator
+{
+public:
+	constexpr IntegerLinearGenerator(W a, W b, W n, W first, W last)
+	: a_(a), d_(b - a), n_(n), first_(first), last_(last)
+	{
+	}
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = T*;
+		using reference         = T&;
+
+		constexpr iterator() : v_(), i_(0) {}
+		constexpr iterator(DDA<W> v, W i) : v_(v), i_(i) {}
+
+		constexpr bool operator==(const iterator& rhs) const { return i_ == rhs.i_; }
+		constexpr bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+		constexpr auto& operator++()      { ++i_; v_.step(); return *this; }
+		constexpr auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		constexpr auto  operator*() const { return T(v_.value()); }
+	private:
+		DDA<W> v_;
+		W i_;
+	};
+
+	constexpr iterator begin() const { return { { a_, d_, n_, first_ }, first_ }; }
+	constexpr iterator end()   const { return { {}, last_ + 1 }; }
+private:
+	W a_, d_, n_;
+	W first_, last_;
+};
+
+template <typename T, typename W>
+class LineGenerator
+{
+public:
+	constexpr LineGenerator(W x0, W y0, W x1, W y1)
+	: x0_(x0), y0_(y0), dx_(x1 - x0), dy_(y1 - y0), 
+	  n_(std::max(dx_ < 0 ? -dx_ : dx_, dy_ < 0 ? -dy_ : dy_))
+	{
+	}
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = point<T>;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = point<T>*;
+		using reference         = point<T>&;
+
+		constexpr iterator() : x_(), y_(), i_(0) {}
+		constexpr iterator(DDA<W> x, DDA<W> y, W i) : x_(x), y_(y), i_(i) {}
+
+		constexpr bool operator==(const iterator& rhs) const { return i_ == rhs.i_; }
+		constexpr bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+		constexpr auto& operator++()      { ++i_; x_.step(); y_.step(); return *this; }
+		constexpr auto  operator++(int)   { auto tmp(*this); ++*this; return tmp; }
+		constexpr auto  operator*() const { return point<T>{ T(x_.value()), T(y_.value()) }; }
+	private:
+		DDA<W> x_, y_;
+		W i_;
+	};
+
+	// n+1 points, n = max(|x1-x0|, |y1-y0|): a single point if both ends coincide
+	constexpr iterator begin() const 
+	{ 
+		return { { x0_, dx_, n_ ? n_ : 1, 0 }, { y0_, dy_, n_ ? n_ : 1, 0 }, 0 }; 
+	}
+	constexpr iterator end() const { return { {}, {}, n_ + 1 }; }
+private:
+	W x0_, y0_, dx_, dy_, n_;
+};
+
+} // end namespace detail
+
+// n+1 integers a + i*(b-a)/n rounded half up, i = 0...n, by error accumulation 
+// instead of floating-point arithmetic, exact for all a, b and n (for 64 bit 
+// types if the compiler provides __int128, else if (b-a)*n fits into 63 bit)
+template <typename Start, typename End, typename N>
+constexpr auto ilinspace(Start a, End b, N n, boundary type = boundary::closed)
+{
+	using Domain = std::common_type_t<Start, End>;
+	using W = detail::dda_counter_t<Domain, N>;
+	static_assert(std::is_integral<Domain>::value, "use integral [a,b]");
+	static_assert(std::is_integral<N>::value,      "use integral n");
+
+	if (n < 1) 
+	{
+		n = 1;
+		type = boundary::open;
+	}
+	
+	bool start_at_one = type == boundary::open || type == boundary::leftopen;
+	bool end_before_n = type == boundary::open || type == boundary::rightopen;
+
+	return detail::IntegerLinearGenerator<Domain, W>(a, b, n, start_at_one, n - end_before_n);
+}
+
+// the points of a rasterized line from (x0, y0) to (x1, y1) inclusive (Bresenham):
+// one step along the major axis per point, the minor axis rounded half up
+template <typename T>
+constexpr auto line(T x0, T y0, T x1, T y1)
+{
+	using W = detail::dda_counter_t<T, std::make_unsigned_t<T>>; // n = max(|x1-x0|, |y1-y0|)
+	static_assert(std::is_integral<T>::value, "use integral coordinates");
+
+	return detail::LineGenerator<T, W>(x0, y0, x1, y1);
+}
+
+// ---[ compile-time tables ]----------------------------------
+
+namespace detail {
+
+// C++14 std::array has no constexpr non-const element access
+template <typename T, std::size_t N>
+struct table { T data[N ? N : 1]; };
+
+template <typename T, std::size_t N, std::size_t... K>
+constexpr std::array<T, N> to_array(const table<T, N>& t, std::index_sequence<K...>) 
+{ 
+	return {{ t.data[K]... }}; 
+}
+
+// not constexpr: a call is a compile error in constant expressions
+[[noreturn]] inline void size_mismatch() { throw std::length_error("to_array<N>(r): r has not N values"); }
+
+} // end namespace detail
+
+// the N values of a range, e.g. static data; a range of another size 
+// does not compile in constant expressions and throws std::length_error
+// at runtime
+// constexpr auto nodes = to_array<5>(linspace(0., 1., 4));
+template <std::size_t N, typename Range>
+constexpr auto to_array(const Range& r)
+{
+	using T = std::decay_t<decltype(*r.begin())>;
+	detail::table<T, N> t{};
+	std::size_t k = 0;
+	auto it = r.begin(), e = r.end();
+
+	for (; k < N && it != e; ++it) t.data[k++] = *it;
+	if (k != N || it != e) detail::size_mismatch();
+	return detail::to_array(t, std::make_index_sequence<N>{});
 }
 
 } // end namespace loop
@@ -0,0 +1,362 @@
+#ifndef LOOP_NUMERIC_H
+#define LOOP_NUMERIC_H
+
+// numerical algorithms on the grids of loop.h: lookup tables, histograms and quadrature
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "loop.h"
+#include "parallel.h"
+
+namespace loop {
+
+// ---[ lookup tables ]----------------------------------
+
+// values y_k = f(x0 + k*dx), k = 0...size()-1, interpolated in O(1) without search
+// and branches: linear(x) piecewise linear, cubic(x) by Catmull-Rom splines, which
+// are exact for quadratic f. Both clamp x to the grid, an empty table yields Value().
+template <typename Value, typename Domain>
+class lookup_table
+{
+	using Coefficients = std::array<Value, 4>;
+
+	// interval i and fraction f of x, clamped to the grid
+	struct Grid
+	{
+		Domain x0, inv_dx, hi;
+		std::ptrdiff_t last;
+
+		void locate(Domain x, std::ptrdiff_t& i, Domain& f) const
+		{
+			Domain t = (x - x0) * inv_dx;
+			t = t > 0 ? t : 0;
+			t = t < hi ? t : hi;
+			i = static_cast<std::ptrdiff_t>(t);
+			i = i < last ? i : last;
+			f = t - static_cast<Domain>(i);
+		}
+	};
+
+public:
+	lookup_table(Domain x0, Domain dx, std::vector<Value> y)
+	: dx_(dx), size_(y.size())
+	{
+		if (y.size() < 2) y.resize(2, y.empty() ? Value() : y[0]);
+
+		// one value beyond each end for cubic(), extrapolated quadratically
+		auto m = y.size();
+		auto left  = m > 2 ? Domain(3) * (y[0] - y[1]) + y[2]         : Domain(2) * y[0] - y[1];
+		auto right = m > 2 ? Domain(3) * (y[m-1] - y[m-2]) + y[m-3] : Domain(2) * y[1] - y[0];
+
+		y_.reserve(m + 2);
+		y_.push_back(left);
+		y_.insert(y_.end(), y.begin(), y.end());
+		y_.push_back(right);
+
+		grid_ = { x0, 1 / dx, static_cast<Domain>(m - 1), std::ptrdiff_t(m) - 2 };
+
+		// cubic() by Horner from the polynomial coefficients of each interval
+		cubic_.resize(m - 1);
+		for (std::size_t i = 0; i + 1 < m; ++i)
+		{
+			const Value &y0 = y_[i], &y1 = y_[i+1], &y2 = y_[i+2], &y3 = y_[i+3];
+			cubic_[i] = {{ y1, Domain(0.5) * (y2 - y0),
+				Domain(0.5) * (Domain(2) * y0 - Domain(5) * y1 + Domain(4) * y2 - y3),
+				Domain(0.5) * (Domain(3) * (y1 - y2) + y3 - y0) }};
+		}
+	}
+
+	std::size_t size() const { return size_; }
+	Domain x0() const { return grid_.x0; }
+	Domain dx() const { return dx_; }
+	const Value& operator[](std::size_t k) const { return y_[k + 1]; }
+
+	Value linear(Domain x) const { return linear(grid_, y_.data() + 1, x); }
+	Value cubic(Domain x)  const { return cubic(grid_, cubic_.data(), x); }
+
+	// out[k] = linear(x[k]) for the samples in [first, last)
+	template <typename InputIt, typename OutputIt>
+	OutputIt linear(InputIt first, InputIt last, OutputIt out) const
+	{
+		const Grid grid = grid_; // not aliased by out
+		const Value* y = y_.data() + 1;
+		for (; first != last; ++first) *out++ = linear(grid, y, *first);
+		return out;
+	}
+
+	// out[k] = cubic(x[k]) for the samples in [first, last)
+	template <typename InputIt, typename OutputIt>
+	OutputIt cubic(InputIt first, InputIt last, OutputIt out) const
+	{
+		const Grid grid = grid_;
+		const Coefficients* c = cubic_.data();
+		for (; first != last; ++first) *out++ = cubic(grid, c, *first);
+		return out;
+	}
+private:
+	static Value linear(const Grid& grid, const Value* y, Domain x)
+	{
+		std::ptrdiff_t i;
+		Domain f;
+		grid.locate(x, i, f);
+		return y[i] + f * (y[i+1] - y[i]);
+	}
+
+	static Value cubic(const Grid& grid, const Coefficients* c, Domain x)
+	{
+		std::ptrdiff_t i;
+		Domain f;
+		grid.locate(x, i, f);
+		auto& ci = c[i];
+		return ci[0] + f * (ci[1] + f * (ci[2] + f * ci[3]));
+	}
+
+	Grid grid_;
+	Domain dx_;
+	std::size_t size_;
+	std::vector<Value> y_; // with one value beyond each end
+	std::vector<Coefficients> cubic_;
+};
+
+// lookup table of f at the values of a linspace() grid, tabulate(f, linspace(0., 1., 1024)).
+// f is called concurrently by the threads (0: all cores), each fills a part of
+// at least 4096 values in a loop which vectorizes where f does.
+template <typename F, typename Domain, typename N, typename Mode>
+auto tabulate(F f, const detail::LinearGenerator<Domain, N, Mode>& grid, unsigned threads = 0)
+{
+	using Value = std::decay_t<decltype(f(grid[0]))>;
+	std::vector<Value> y(grid.size());
+	const auto n = std::ptrdiff_t(y.size());
+
+	detail::parallel_parts(n, detail::thread_count(n, threads, 4096),
+		[&](unsigned, std::ptrdiff_t begin, std::ptrdiff_t end)
+		{
+			for (auto k = begin; k < end; ++k) y[std::size_t(k)] = f(grid[std::size_t(k)]);
+		});
+	return lookup_table<Value, Domain>(grid[0], grid.dx(), std::move(y));
+}
+
+// ---[ histograms ]----------------------------------
+
+// counts of the samples per bin of bucketize(), size()+1 bins. 
+// Each of the threads (0: all cores) counts a part of the samples into 
+// its own bins, which are added at the end.
+template <typename Domain, typename N, typename Mode, typename RandomIt>
+std::vector<std::size_t> histogram(const detail::LinearGenerator<Domain, N, Mode>& edges, 
+	RandomIt first, RandomIt last, unsigned threads = 0)
+{
+	const std::size_t bins = edges.size() + 1;
+	const std::ptrdiff_t block = 1024, samples = std::distance(first, last);
+	const unsigned parts = detail::thread_count(samples, threads, 64 * block);
+
+	std::vector<std::vector<std::size_t>> counts(parts, std::vector<std::size_t>(bins));
+	detail::parallel_parts(samples, parts, [&](unsigned t, std::ptrdiff_t begin, std::ptrdiff_t end)
+		{
+			auto& c = counts[t];
+			N index[block];
+			while (begin != end)
+			{
+				auto n = std::min<std::ptrdiff_t>(block, end - begin);
+				edges.bucketize(first + begin, first + begin + n, index);
+				for (std::ptrdiff_t k = 0; k < n; ++k) ++c[std::size_t(index[k])];
+				begin += n;
+			}
+		});
+
+	for (unsigned t = 1; t < parts; ++t)
+	{
+		for (std::size_t k = 0; k < bins; ++k) counts[0][k] += counts[t][k];
+	}
+	return counts[0];
+}
+
+// ---[ quadrature ]----------------------------------
+
+// Rules of integrate(): trapezoid and simpson weight the grid values, with 
+// weights of the end values changed for an end excluded by the boundary 
+// of the grid, so f is never evaluated there. gauss_legendre evaluates f 
+// inside each interval of the grid, independent of its boundary.
+namespace quadrature {
+
+// second order: weights 1/2, 1, ..., an excluded end 0, 2, 1/2, 1, ...
+// (the end value extrapolated linearly), exact for linear f
+struct trapezoid
+{
+	static constexpr std::size_t reach(bool open) { return open ? 3 : 1; }
+	static constexpr double weight(std::size_t i, bool open)
+	{
+		return open ? (i == 0 ? 0 : i == 1 ? 2 : i == 2 ? 0.5 : 1) : (i == 0 ? 0.5 : 1);
+	}
+};
+
+// fourth order, the extended Simpson rule for any n (Numerical Recipes 4.1.14)
+// with the end weights 3/8, 7/6, 23/24, 1, ..., an excluded end 0, 8/3, -31/24, 
+// 5/2, 5/8, 1, ... (the end value extrapolated cubically), exact for cubic f
+struct simpson
+{
+	static constexpr std::size_t reach(bool open) { return open ? 5 : 3; }
+	static constexpr double weight(std::size_t i, bool open)
+	{
+		return open 
+			? (i == 0 ? 0 : i == 1 ? 8./3 : i == 2 ? -31./24 : i == 3 ? 5./2 : i == 4 ? 5./8 : 1) 
+			: (i == 0 ? 3./8 : i == 1 ? 7./6 : i == 2 ? 23./24 : 1);
+	}
+};
+
+// Points nodes per interval of the grid, order 2*Points, exact for 
+// polynomials of degree 2*Points-1
+template <int Points = 3>
+struct gauss_legendre
+{
+	static_assert(Points >= 1 && Points <= 5, "use 1 to 5 points");
+
+	// node j = 0...Points-1 on [0, 1] and its weight
+	static constexpr double node(int j)   { return 0.5 + (2 * j < Points - 1 ? -0.5 : 0.5) * root(rank(j)); }
+	static constexpr double weight(int j) { return 0.5 * weight_of_root(rank(j)); }
+private:
+	// the nodes are symmetric: rank 0 is the root nearest to 0
+	static constexpr int rank(int j) { return (2 * j < Points - 1 ? Points - 1 - 2 * j : 2 * j - Points + 1) / 2; }
+
+	// nonnegative roots of the Legendre polynomial on [-1, 1] and their weights
+	static constexpr double root(int r)
+	{
+		return Points == 1 ? 0 
+			: Points == 2 ? 0.57735026918962576451
+			: Points == 3 ? (r == 0 ? 0 : 0.77459666924148337704)
+			: Points == 4 ? (r == 0 ? 0.33998104358485626480 : 0.86113631159405257522)
+			: (r == 0 ? 0 : r == 1 ? 0.53846931010568309104 : 0.90617984593866399280);
+	}
+	static constexpr double weight_of_root(int r)
+	{
+		return Points == 1 ? 2 
+			: Points == 2 ? 1
+			: Points == 3 ? (r == 0 ? 8./9 : 5./9)
+			: Points == 4 ? (r == 0 ? 0.65214515486254614263 : 0.34785484513745385737)
+			: (r == 0 ? 128./225 : r == 1 ? 0.47862867049936646804 : 0.23692688505618908751);
+	}
+};
+
+} // end namespace quadrature
+
+namespace detail {
+
+// Kahan's compensated sum
+template <typename T>
+struct compensated_sum
+{
+	T s{}, c{};
+
+	void add(T x)
+	{
+		T y = x - c, t = s + y;
+		c = (t - s) - y;
+		s = t;
+	}
+};
+
+// sum of g(k), k = 0...n-1, in blocks of 1024 terms summed in 8 partial sums, 
+// the sums of the blocks added with compensation: the error does not grow 
+// with n, the result does not depend on the number of threads (0: all cores)
+template <typename T, typename G>
+T parallel_sum(std::ptrdiff_t n, unsigned threads, G g)
+{
+	const std::ptrdiff_t block = 1024, lanes = 8;
+	std::vector<T> sums(std::size_t((n + block - 1) / block));
+	const auto blocks = std::ptrdiff_t(sums.size());
+
+	parallel_parts(blocks, thread_count(blocks, threads, 16), 
+		[&](unsigned, std::ptrdiff_t begin, std::ptrdiff_t end)
+		{
+			for (auto b = begin; b < end; ++b)
+			{
+				T s[lanes] = {};
+				auto k = b * block, last = std::min(k + block, n);
+				for (; k + lanes <= last; k += lanes)
+				{
+					for (std::ptrdiff_t j = 0; j < lanes; ++j) s[j] += g(k + j);
+				}
+				for (std::ptrdiff_t j = 0; k < last; ++k, ++j) s[j] += g(k);
+				sums[std::size_t(b)] = ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+			}
+		});
+
+	compensated_sum<T> sum;
+	for (auto& s : sums) sum.add(s);
+	return sum.s;
+}
+
+} // end namespace detail
+
+namespace detail {
+
+// sum += (weight - 1) * f for the end values with weights other than 1, 
+// false if the grid is too short for the rule
+template <typename Rule, typename Value, typename F, typename Grid>
+bool add_end_weights(Value& sum, F& f, const Grid& grid)
+{
+	using Domain = decltype(grid.a());
+	const auto n = std::size_t(grid.n()), first = std::size_t(grid.first()), last = std::size_t(grid.last());
+	const bool left_open = first > 0, right_open = last < n;
+	if (Rule::reach(left_open) + Rule::reach(right_open) > n + 1) return false;
+
+	// i: the distance to the end
+	for (std::size_t i = first; i < Rule::reach(left_open); ++i)
+	{
+		sum += static_cast<Domain>(Rule::weight(i, left_open) - 1) * f(grid[i - first]);
+	}
+	for (std::size_t i = n - last; i < Rule::reach(right_open); ++i)
+	{
+		sum += static_cast<Domain>(Rule::weight(i, right_open) - 1) * f(grid[n - i - first]);
+	}
+	return true;
+}
+
+} // end namespace detail
+
+// integral of f over [a, b] from the values of f on the grid linspace(a, b, n), 
+// e.g. integrate(f, linspace(0., 1., 1000), quadrature::simpson{}). The terms 
+// are summed in threads (0: all cores), f is called concurrently. Grids too 
+// short for the end weights of simpson fall back to trapezoid, then to 
+// (b-a) times the mean of the values.
+template <typename F, typename Domain, typename N, typename Mode, typename Rule = quadrature::simpson>
+auto integrate(F f, const detail::LinearGenerator<Domain, N, Mode>& grid, Rule = {}, unsigned threads = 0)
+{
+	using Value = std::decay_t<decltype(f(grid[0]) * grid.dx())>;
+	const auto count = std::ptrdiff_t(grid.size());
+
+	Value sum = detail::parallel_sum<Value>(count, threads, [&](std::ptrdiff_t k) { return f(grid[std::size_t(k)]); });
+
+	if (detail::add_end_weights<Rule>(sum, f, grid) || detail::add_end_weights<quadrature::trapezoid>(sum, f, grid))
+	{
+		return sum * grid.dx();
+	}
+	return count ? sum * (grid.dx() * static_cast<Domain>(grid.n()) / static_cast<Domain>(count)) : Value();
+}
+
+template <typename F, typename Domain, typename N, typename Mode, int Points>
+auto integrate(F f, const detail::LinearGenerator<Domain, N, Mode>& grid, quadrature::gauss_legendre<Points>, unsigned threads = 0)
+{
+	using Rule = quadrature::gauss_legendre<Points>;
+	using Value = std::decay_t<decltype(f(grid.a()) * grid.dx())>;
+	const Domain a = grid.a(), dx = grid.dx();
+
+	// the interval [a + k*dx, a + (k+1)*dx]
+	Value sum = detail::parallel_sum<Value>(std::ptrdiff_t(grid.n()), threads, [&](std::ptrdiff_t k)
+		{
+			Value s{};
+			for (int j = 0; j < Points; ++j)
+			{
+				s += static_cast<Domain>(Rule::weight(j)) * f(a + (static_cast<Domain>(k) + static_cast<Domain>(Rule::node(j))) * dx);
+			}
+			return s;
+		});
+	return sum * dx;
+}
+
+} // end namespace loop
+
+#endif // LOOP_NUMERIC_H
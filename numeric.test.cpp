@@ -0,0 +1,223 @@
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "catch.hpp"
+#include "numeric.h"
+
+TEST_CASE("lookup tables on linspace grids", "[tabulate]")
+{
+	const double pi = std::acos(-1.);
+
+	SECTION("tabulate(f, linspace(0, 1, 4))")
+	{
+		auto t = loop::tabulate([](double x) { return 2 * x + 1; }, loop::linspace(0., 1., 4));
+		REQUIRE(t.size() == 5u);
+		REQUIRE(t[0] == 1.);
+		REQUIRE(t[4] == 3.);
+		REQUIRE(t.x0() == 0.);
+		REQUIRE(t.dx() == .25);
+		REQUIRE(t.linear(0.3) == Approx(1.6));
+		REQUIRE(t.cubic(0.3) == Approx(1.6));
+	}
+
+	SECTION("clamped to the grid")
+	{
+		auto t = loop::tabulate([](double x) { return x * x; }, loop::linspace(-1., 2., 30));
+		REQUIRE(t.linear(-5.) == 1.);
+		REQUIRE(t.cubic(-5.) == 1.);
+		REQUIRE(t.linear(2.) == Approx(4.));
+		REQUIRE(t.cubic(7.) == Approx(4.));
+		REQUIRE(t.linear(std::nan("")) == 1.);
+	}
+
+	SECTION("exact for linear (linear) and quadratic (cubic) functions")
+	{
+		auto line = [](double x) { return 3 - 0.5 * x; };
+		auto parabola = [](double x) { return 1 + x * (2 - 3 * x); };
+		auto t1 = loop::tabulate(line, loop::linspace(-2., 3., 17));
+		auto t2 = loop::tabulate(parabola, loop::linspace(-2., 3., 17));
+
+		for (auto x : loop::linspace(-2., 3., 1000))
+		{
+			REQUIRE(std::abs(t1.linear(x) - line(x)) <= 1e-14);
+			REQUIRE(std::abs(t2.cubic(x) - parabola(x)) <= 1e-13);
+		}
+	}
+
+	SECTION("interpolation errors O(h^2), O(h^3)")
+	{
+		int n = 1000;
+		double h = 2 * pi / n;
+		auto t = loop::tabulate([](double x) { return std::sin(x); }, loop::linspace(0., 2 * pi, n));
+
+		double linear = 0, cubic = 0;
+		for (auto x : loop::linspace(0., 2 * pi, 7 * n + 3))
+		{
+			linear = std::max(linear, std::abs(t.linear(x) - std::sin(x)));
+			cubic  = std::max(cubic,  std::abs(t.cubic(x) - std::sin(x)));
+		}
+		REQUIRE(linear <= h * h / 8);
+		REQUIRE(cubic <= h * h * h / 8);
+	}
+
+	SECTION("batch evaluation equals single values")
+	{
+		auto t = loop::tabulate([](double x) { return std::exp(x); }, loop::linspace(0., 1., 100));
+		std::vector<double> x, y1(1001), y3(1001);
+		for (auto xi : loop::linspace(-0.1, 1.1, 1000)) x.push_back(xi);
+
+		t.linear(x.begin(), x.end(), y1.begin());
+		t.cubic(x.begin(), x.end(), y3.begin());
+		for (std::size_t k = 0; k < x.size(); ++k)
+		{
+			REQUIRE(y1[k] == t.linear(x[k]));
+			REQUIRE(y3[k] == t.cubic(x[k]));
+		}
+	}
+
+	SECTION("same table from 1 and 4 threads")
+	{
+		auto f = [](double x) { return std::cos(x) * x; };
+		auto grid = loop::linspace(0., 10., 100000, loop::boundary::open);
+		auto t1 = loop::tabulate(f, grid, 1), t4 = loop::tabulate(f, grid, 4);
+
+		REQUIRE(t1.size() == grid.size());
+		REQUIRE(t4.size() == grid.size());
+		for (std::size_t k = 0; k < t1.size(); ++k)
+		{
+			REQUIRE(t1[k] == f(grid[k]));
+			REQUIRE(t4[k] == t1[k]);
+		}
+	}
+
+	SECTION("descending grids, complex values, a single value")
+	{
+		auto down = loop::tabulate([](double x) { return x * x; }, loop::linspace(2., -1., 30));
+		REQUIRE(down.cubic(0.5) == Approx(0.25));
+		REQUIRE(down.linear(-3.) == 1.);
+
+		auto z = loop::tabulate([](double x) { return std::polar(1., x); }, loop::linspace(0., pi, 1000));
+		REQUIRE(std::abs(z.cubic(1.) - std::polar(1., 1.)) <= 1e-9);
+
+		auto one = loop::tabulate([](double) { return 7.; }, loop::linspace(0., 1., 2, loop::boundary::open));
+		REQUIRE(one.size() == 1u);
+		REQUIRE(one.linear(0.1) == 7.);
+		REQUIRE(one.cubic(0.9) == 7.);
+	}
+}
+
+TEST_CASE("histograms on linspace edges", "[histogram]")
+{
+	auto edges = loop::linspace(-1., 1., 20);
+	std::vector<double> x;
+	for (auto xi : loop::linspace(-1.25, 1.25, 300000)) x.push_back(xi);
+
+	std::vector<std::size_t> expected(22);
+	for (auto xi : x) ++expected[edges.index_of(xi)];
+
+	REQUIRE(loop::histogram(edges, x.begin(), x.end(), 1) == expected);
+	REQUIRE(loop::histogram(edges, x.begin(), x.end(), 4) == expected);
+	REQUIRE(loop::histogram(edges, x.begin(), x.end()) == expected);
+	REQUIRE(loop::histogram(edges, x.begin(), x.begin()) == std::vector<std::size_t>(22));
+}
+
+TEST_CASE("quadrature on linspace grids", "[integrate]")
+{
+	using loop::boundary;
+	namespace q = loop::quadrature;
+	const auto boundaries = { boundary::closed, boundary::rightopen, boundary::leftopen, boundary::open };
+
+	auto polynomial = [](int degree) 
+		{ 
+			return [degree](double x) { double p = 1; for (int k = 0; k < degree; ++k) p = p * x + (k + 2); return p; }; 
+		};
+	auto integral = [](int degree, double a, double b)
+		{
+			// antiderivative of the coefficients of polynomial(degree)
+			std::vector<double> c(std::size_t(degree) + 1);
+			c[0] = 1;
+			for (int k = 0; k < degree; ++k) c[std::size_t(k) + 1] = k + 2;
+			auto F = [&](double x)
+				{
+					double s = 0;
+					for (std::size_t k = 0; k < c.size(); ++k) s += c[k] * std::pow(x, double(c.size() - k)) / double(c.size() - k);
+					return s;
+				};
+			return F(b) - F(a);
+		};
+
+	SECTION("integrate(f, linspace(0, 1, 4))")
+	{
+		auto f = [](double x) { return x; };
+		REQUIRE(loop::integrate(f, loop::linspace(0., 1., 4), q::trapezoid{}) == Approx(0.5));
+		REQUIRE(loop::integrate(f, loop::linspace(0., 1., 4), q::gauss_legendre<1>{}) == Approx(0.5));
+		REQUIRE(loop::integrate(f, loop::linspace(0., 1., 8)) == Approx(0.5));
+	}
+
+	SECTION("exact for polynomials of the order of the rule, all boundaries")
+	{
+		for (auto type : boundaries)
+		for (int n : { 9, 10, 11, 57 })
+		{
+			auto grid = loop::linspace(-1., 2., n, type);
+			INFO("n = " << n << ", boundary " << int(type));
+			REQUIRE(loop::integrate(polynomial(1), grid, q::trapezoid{}) == Approx(integral(1, -1, 2)).epsilon(1e-13));
+			REQUIRE(loop::integrate(polynomial(3), grid, q::simpson{}) == Approx(integral(3, -1, 2)).epsilon(1e-13));
+			REQUIRE(loop::integrate(polynomial(1), grid, q::gauss_legendre<1>{}) == Approx(integral(1, -1, 2)).epsilon(1e-13));
+			REQUIRE(loop::integrate(polynomial(3), grid, q::gauss_legendre<2>{}) == Approx(integral(3, -1, 2)).epsilon(1e-13));
+			REQUIRE(loop::integrate(polynomial(5), grid, q::gauss_legendre<3>{}) == Approx(integral(5, -1, 2)).epsilon(1e-13));
+			REQUIRE(loop::integrate(polynomial(7), grid, q::gauss_legendre<4>{}) == Approx(integral(7, -1, 2)).epsilon(1e-13));
+			REQUIRE(loop::integrate(polynomial(9), grid, q::gauss_legendre<5>{}) == Approx(integral(9, -1, 2)).epsilon(1e-13));
+		}
+	}
+
+	SECTION("order of convergence")
+	{
+		auto f = [](double x) { return std::exp(x); };
+		const double exact = std::exp(1.) - 1;
+		for (auto type : boundaries)
+		{
+			auto error = [&](int n, auto rule) { return std::abs(loop::integrate(f, loop::linspace(0., 1., n, type), rule) - exact); };
+			INFO("boundary " << int(type));
+			auto trapezoid = error(100, q::trapezoid{}) / error(200, q::trapezoid{});
+			auto simpson = error(100, q::simpson{}) / error(200, q::simpson{});
+			REQUIRE(trapezoid == Approx(4).epsilon(0.1));
+			REQUIRE(simpson == Approx(16).epsilon(0.2));
+			REQUIRE(error(100, q::simpson{}) <= 1e-8);
+			REQUIRE(error(10, q::gauss_legendre<3>{}) <= 1e-12);
+		}
+	}
+
+	SECTION("f is not evaluated at excluded ends")
+	{
+		double lowest = 1, highest = 0;
+		auto f = [&](double x) { lowest = std::min(lowest, x); highest = std::max(highest, x); return 1 / std::sqrt(x); };
+
+		auto value = loop::integrate(f, loop::linspace(0., 1., 1000, boundary::leftopen), q::simpson{}, 1);
+		REQUIRE(lowest > 0);
+		REQUIRE(highest == 1);
+		REQUIRE(value == Approx(2).epsilon(0.05));
+	}
+
+	SECTION("short grids")
+	{
+		auto f = [](double x) { return 2 * x; };
+		REQUIRE(loop::integrate(f, loop::linspace(0., 1., 1)) == Approx(1));
+		REQUIRE(loop::integrate(f, loop::linspace(0., 1., 2, boundary::open)) == Approx(1));
+		REQUIRE(loop::integrate(f, loop::linspace(0., 1., 3, boundary::rightopen)) == Approx(1));
+		REQUIRE(loop::integrate(f, loop::linspace(0., 1., 1, boundary::open)) == 0);
+	}
+
+	SECTION("compensated sums, independent of the number of threads")
+	{
+		auto f = [](double x) { return 0.1 + x * 0; };
+		auto grid = loop::linspace(0., 1., 3000000);
+		auto s1 = loop::integrate(f, grid, q::trapezoid{}, 1);
+		auto s4 = loop::integrate(f, grid, q::trapezoid{}, 4);
+		REQUIRE(s1 == s4);
+		REQUIRE(std::abs(s1 - 0.1) <= 1e-15);
+
+		auto z = loop::integrate([](double x) { return std::polar(1., x); }, loop::linspace(0., std::acos(-1.), 1000));
+		REQUIRE(std::abs(z - std::complex<double>(0, 2)) <= 1e-10);
+	}
+}
@@ -0,0 +1,37 @@
+#ifndef LOOP_PARALLEL_H
+#define LOOP_PARALLEL_H
+
+// parts of loops in threads, shared by numeric.h and distributed.h
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace loop {
+namespace detail {
+
+// threads (0: all cores) for n items, at least min_part items each
+inline unsigned thread_count(std::ptrdiff_t n, unsigned threads, std::ptrdiff_t min_part)
+{
+	static const unsigned cores = std::max(1u, std::thread::hardware_concurrency()); // reads /sys
+	if (threads == 0) threads = cores;
+	return unsigned(std::max<std::ptrdiff_t>(1, std::min<std::ptrdiff_t>(threads, n / min_part)));
+}
+
+// f(part, begin, end) for the parts of [0, n), each in a thread
+template <typename F>
+void parallel_parts(std::ptrdiff_t n, unsigned parts, F f)
+{
+	auto run = [&](unsigned t) { f(t, n * t / parts, n * (t + 1) / parts); };
+
+	std::vector<std::thread> workers;
+	for (unsigned t = 1; t < parts; ++t) workers.emplace_back(run, t);
+	run(0);
+	for (auto& w : workers) w.join();
+}
+
+} // end namespace detail
+} // end namespace loop
+
+#endif // LOOP_PARALLEL_H
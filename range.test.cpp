@@ -1,3 +1,12 @@
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
 #include <vector>
 #include "catch.hpp"
 #include "loop.h"
@@ -215,3 +224,600 @@ TEST_CASE("range iterator increment", "[intrange]")
 	
 	REQUIRE(i1 == i2);
 }
+
+TEST_CASE("integer range with compile-time step", "[intrange]")
+{
+	using Vec = std::vector<int>;
+	Vec v;
+
+	SECTION("range(0, 10, step<4>())") 
+	{
+		for (auto i : loop::range(0, 10, loop::step<4>())) v.push_back(i);
+		REQUIRE(v == Vec({ 0, 4, 8 }));
+	}
+
+	SECTION("range(0, 8, step<4>(), true)") 
+	{
+		for (auto i : loop::range(0, 8, loop::step<4>(), true)) v.push_back(i);
+		REQUIRE(v == Vec({ 0, 4, 8 }));
+	}
+
+	SECTION("range(5, 0, step<-1>())") 
+	{
+		for (auto i : loop::range(5, 0, loop::step<-1>())) v.push_back(i);
+		REQUIRE(v == Vec({ 5, 4, 3, 2, 1 }));
+	}
+
+	SECTION("range(9u, 0, step<-2>())") 
+	{
+		for (auto i : loop::range(9u, 0, loop::step<-2>())) v.push_back(i);
+		REQUIRE(v == Vec({ 9, 7, 5, 3, 1 }));
+	}
+
+	SECTION("range(0, 5, step<-1>())") 
+	{
+		for (auto i : loop::range(0, 5, loop::step<-1>())) v.push_back(i);
+		REQUIRE(v == Vec{});
+	}
+
+	SECTION("range(1, 1, step<0>(), true)") 
+	{
+		for (auto i : loop::range(1, 1, loop::step<0>(), true)) v.push_back(i);
+		REQUIRE(v == Vec({ 1 }));
+	}
+
+	SECTION("step type does not widen the domain") 
+	{
+		auto r = loop::range(short(0), short(4), loop::step<2>());
+		REQUIRE((std::is_same<decltype(*r.begin()), int>::value));
+		REQUIRE((std::is_same<decltype(*loop::range(0u, 4u, loop::step<2>()).begin()), unsigned>::value));
+	}
+}
+
+TEST_CASE("integer range near the limits of the domain", "[intrange]")
+{
+	using Vec = std::vector<int>;
+	const int max = std::numeric_limits<int>::max();
+	const int min = std::numeric_limits<int>::min();
+	Vec v;
+
+	SECTION("range(max-3, max, 1, true)") 
+	{
+		for (auto i : loop::range(max-3, max, 1, true)) v.push_back(i);
+		REQUIRE(v == Vec({ max-3, max-2, max-1, max }));
+	}
+
+	SECTION("range(max-4, max, 3)") 
+	{
+		for (auto i : loop::range(max-4, max, 3)) v.push_back(i);
+		REQUIRE(v == Vec({ max-4, max-1 }));
+	}
+
+	SECTION("range(min+3, min, -1, true)") 
+	{
+		for (auto i : loop::range(min+3, min, -1, true)) v.push_back(i);
+		REQUIRE(v == Vec({ min+3, min+2, min+1, min }));
+	}
+
+	SECTION("range(min, max-1, max)") 
+	{
+		for (auto i : loop::range(min, max-1, max)) v.push_back(i);
+		REQUIRE(v == Vec({ min, -1 }));
+	}
+
+	SECTION("countdown(max)") 
+	{
+		auto r = loop::countdown(max);
+		REQUIRE(*r.begin() == max-1);
+	}
+}
+
+TEST_CASE("unsigned range up to the limits of the domain", "[intrange]")
+{
+	using Vec = std::vector<unsigned>;
+	const unsigned max = std::numeric_limits<unsigned>::max();
+	Vec v;
+
+	SECTION("range(max-2, max, 1, true)") 
+	{
+		for (auto i : loop::range(max-2, max, 1, true)) v.push_back(i);
+		REQUIRE(v == Vec({ max-2, max-1, max }));
+	}
+
+	SECTION("range(0u, max, 1u<<30, true)") 
+	{
+		for (auto i : loop::range(0u, max, 1u<<30, true)) v.push_back(i);
+		REQUIRE(v == Vec({ 0, 1u<<30, 2u<<30, 3u<<30 }));
+	}
+
+	SECTION("range(max, 0u, -(1<<30), true)") 
+	{
+		for (auto i : loop::range(max, 0u, -(1<<30), true)) v.push_back(i);
+		REQUIRE(v == Vec({ max, max - (1u<<30), max - (2u<<30), max - (3u<<30) }));
+	}
+}
+
+TEST_CASE("signed char ranges match the loop for (int i = a; i < b; i += s)", "[intrange]")
+{
+	using Vec = std::vector<int>;
+	using T = signed char;
+
+	for (int a = -128; a < 128; ++a)
+	for (int b = -128; b < 128; ++b)
+	for (int s : { -128, -127, -64, -3, -2, -1, 1, 2, 3, 64, 127 })
+	for (bool with_end : { false, true })
+	{
+		Vec expected, v;
+		for (int i = a; s > 0 ? (i < b || (with_end && i == b)) : (i > b || (with_end && i == b)); i += s)
+		{
+			expected.push_back(i);
+		}
+		for (auto i : loop::range(T(a), T(b), T(s), with_end)) v.push_back(i);
+
+		if (v != expected)
+		{
+			INFO("range(" << a << ", " << b << ", " << s << ", " << with_end << ")");
+			REQUIRE(v == expected);
+		}
+	}
+}
+
+TEST_CASE("ranges over the full domain of the type", "[intrange]")
+{
+	SECTION("signed char and unsigned char") 
+	{
+		std::vector<int> v, expected;
+		for (int i = -128; i < 128; ++i) expected.push_back(i);
+
+		for (auto i : loop::range((signed char)-128, (signed char)127, 1, true)) v.push_back(i);
+		REQUIRE(v == expected);
+
+		v.clear();
+		for (auto i : loop::range((unsigned char)0, (unsigned char)255, 1, true)) v.push_back(i);
+		REQUIRE(v.size() == 256u);
+		REQUIRE(v.back() == 255);
+	}
+
+	SECTION("int, step 2^30") 
+	{
+		using Vec = std::vector<int>;
+		const int max = std::numeric_limits<int>::max();
+		const int min = std::numeric_limits<int>::min();
+		Vec v;
+
+		for (auto i : loop::range(min, max, 1<<30, true)) v.push_back(i);
+		REQUIRE(v == Vec({ min, -(1<<30), 0, 1<<30 }));
+
+		v.clear();
+		for (auto i : loop::range(max, min, -(1<<30), true)) v.push_back(i);
+		REQUIRE(v == Vec({ max, max - (1<<30), max - (1<<30) - (1<<30), -(1<<30) - 1 }));
+	}
+
+	SECTION("64 bit, step 2^62") 
+	{
+		using Vec = std::vector<unsigned long long>;
+		const auto max = std::numeric_limits<unsigned long long>::max();
+		const auto q = 1ull << 62;
+		Vec v;
+
+		for (auto i : loop::range(0ull, max, q, true)) v.push_back(i);
+		REQUIRE(v == Vec({ 0, q, 2*q, 3*q }));
+
+		std::vector<long long> w;
+		for (auto i : loop::range(std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max(), 1ll << 62, true)) w.push_back(i);
+		REQUIRE(w.size() == 4u);
+		REQUIRE(w[2] == 0);
+	}
+
+	SECTION("range(0, SIZE_MAX, 1, true)") 
+	{
+		std::vector<std::size_t> v;
+		for (auto i : loop::range(std::size_t(0), SIZE_MAX, 1, true))
+		{
+			v.push_back(i);
+			if (v.size() == 3) break;
+		}
+		REQUIRE(v == std::vector<std::size_t>({ 0, 1, 2 }));
+
+		auto r = loop::range(std::size_t(0), SIZE_MAX, 1, true);
+		REQUIRE(r.begin() != r.end());
+	}
+}
+
+TEST_CASE("closed-form algorithms on integral ranges match linear scans", "[rangealgo]")
+{
+	using Vec = std::vector<long long>;
+	auto check = [](auto r, bool descending)
+	{
+		Vec v(r.begin(), r.end());
+		long long scanned = 0;
+		for (auto i : r) scanned += i;
+
+		REQUIRE(r.size() == v.size());
+		REQUIRE(r.empty() == v.empty());
+		REQUIRE(std::distance(r.begin(), r.end()) == std::ptrdiff_t(v.size()));
+		REQUIRE(static_cast<long long>(r.sum()) == scanned);
+		if (v.empty()) return;
+
+		REQUIRE(static_cast<long long>(r.front()) == v.front());
+		REQUIRE(static_cast<long long>(r.back()) == v.back());
+		for (std::size_t k = 0; k < v.size(); ++k) REQUIRE(static_cast<long long>(r[k]) == v[k]);
+
+		for (int probe = -30; probe <= 30; ++probe)
+		{
+			const auto x = decltype(r.front())(probe); // as compared by the range
+			auto index = [&](auto it) { return std::distance(r.begin(), it); };
+			auto expected = std::find(v.begin(), v.end(), x);
+			auto lower = descending 
+				? std::lower_bound(v.begin(), v.end(), x, std::greater<>()) 
+				: std::lower_bound(v.begin(), v.end(), x);
+			auto upper = descending 
+				? std::upper_bound(v.begin(), v.end(), x, std::greater<>()) 
+				: std::upper_bound(v.begin(), v.end(), x);
+
+			INFO("x = " << x);
+			REQUIRE(r.contains(x) == (expected != v.end()));
+			REQUIRE(index(r.find(x)) == std::distance(v.begin(), expected));
+			REQUIRE(index(r.lower_bound(x)) == std::distance(v.begin(), lower));
+			REQUIRE(index(r.upper_bound(x)) == std::distance(v.begin(), upper));
+
+			// argument-dependent lookup on subranges
+			auto first = std::next(r.begin()), last = r.end() - 1;
+			if (first <= last)
+			{
+				auto sub = std::find(v.begin() + 1, v.end() - 1, x);
+				REQUIRE(index(find(first, last, x)) == std::distance(v.begin(), sub));
+				REQUIRE(count(first, last, x) == std::count(v.begin() + 1, v.end() - 1, x));
+			}
+		}
+	};
+
+	for (int a : { -20, -7, 0, 3, 19 })
+	for (int b : { -20, -6, 0, 4, 19 })
+	for (int s : { -5, -2, -1, 1, 3, 7 })
+	{
+		INFO("range(" << a << ", " << b << ", " << s << ")");
+		check(loop::range(a, b, s), s < 0);
+		check(loop::range(a, b, s, true), s < 0);
+		check(loop::range((long long)a, b, (long long)s), s < 0);
+	}
+	check(loop::range(25), false);
+	check(loop::range(-3, 12), false);
+	check(loop::range(12, -3, loop::step<-1>()), true);
+	check(loop::countdown(17u), true);
+	check(loop::range(2u, 29u, 3u), false);
+	check(loop::range(29u, 2u, -3), true);
+	check(loop::range(20ull, 0, -7, true), true);
+
+	SECTION("sums beyond the domain of the type") 
+	{
+		const int min = std::numeric_limits<int>::min(), max = std::numeric_limits<int>::max();
+		auto full = loop::range(min, max, 1, true);
+		REQUIRE(full.size() == (std::size_t(1) << 32));
+		REQUIRE(full.sum() == min);
+		REQUIRE(loop::range(0, max).sum() == std::int64_t(max) * (max - 1) / 2);
+		REQUIRE(loop::range(0, max).sum<int>() == int(std::int64_t(max) * (max - 1) / 2));
+		REQUIRE(std::distance(full.begin(), full.end()) == std::ptrdiff_t(1) << 32);
+		REQUIRE(full.contains(max));
+		REQUIRE(*full.upper_bound(-1) == 0);
+
+		auto u = loop::range(std::uint64_t(0), ~std::uint64_t(0), std::uint64_t(3), true);
+		REQUIRE(u.size() == ~std::uint64_t(0) / 3 + 1);
+		REQUIRE(u.back() == ~std::uint64_t(0));
+		REQUIRE(u.contains(~std::uint64_t(0) - 3));
+		REQUIRE(!u.contains(1));
+		REQUIRE(u.lower_bound(~std::uint64_t(0) - 2) == u.end() - 1);
+		const std::uint64_t last = ~std::uint64_t(0) / 3; // odd
+		REQUIRE(u.sum<std::uint64_t>() == 3 * last * (last / 2 + 1));
+#ifdef __SIZEOF_INT128__
+		__extension__ typedef unsigned __int128 uint128;
+		REQUIRE((u.sum() == 3 * (uint128(last) * (last + 1) / 2)));
+#endif
+	}
+
+	SECTION("random access iterators") 
+	{
+		auto r = loop::range(10, -10, -3);
+		REQUIRE(r.size() == 7u);
+		REQUIRE(*(r.begin() + 3) == 1);
+		REQUIRE(*(r.end() - 1) == -8);
+		REQUIRE(std::distance(r.begin(), r.end()) == 7);
+		REQUIRE(std::distance(r.end(), r.begin()) == -7);
+		REQUIRE(r.begin() < r.end());
+		REQUIRE(r.begin()[6] == -8);
+		REQUIRE(std::binary_search(r.begin(), r.end(), -5, std::greater<int>()));
+		REQUIRE(*std::prev(r.end(), 2) == -5);
+
+		auto full = loop::range((signed char)-128, (signed char)127, (signed char)64, true);
+		auto it = full.end();
+		it -= 4;
+		REQUIRE(it == full.begin());
+		it += 4;
+		REQUIRE(it == full.end());
+		REQUIRE(std::distance(full.begin(), full.end()) == 4);
+		REQUIRE(!full.empty());
+	}
+}
+
+TEST_CASE("range algebra matches filtered values", "[rangealgebra]")
+{
+	using Vec = std::vector<long long>;
+	auto values = [](auto r) { return Vec(r.begin(), r.end()); };
+	auto join = [](Vec a, const Vec& b) { a.insert(a.end(), b.begin(), b.end()); return a; };
+
+	for (int a : { -12, -3, 6 })
+	for (int b : { -13, 2, 13 })
+	for (int s : { -3, -1, 2, 5 })
+	{
+		auto r = loop::range(a, b, s, true);
+		auto v = values(r);
+		INFO("range(" << a << ", " << b << ", " << s << ", true)");
+
+		Vec reversed(v.rbegin(), v.rend());
+		REQUIRE(values(r.reverse()) == reversed);
+
+		for (std::size_t k = 0; k <= v.size() + 1; ++k)
+		{
+			auto parts = r.split_at(k);
+			REQUIRE(values(parts.first) == Vec(v.begin(), v.begin() + std::min(k, v.size())));
+			REQUIRE(join(values(parts.first), values(parts.second)) == v);
+			REQUIRE(values(r.first(k)) == values(parts.first));
+			REQUIRE(values(r.drop(k)) == values(parts.second));
+		}
+
+		for (std::size_t count : { 1, 2, 3, 7 })
+		{
+			Vec all;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				auto shard = r.shard(i, count);
+				REQUIRE(shard.size() >= v.size() / count);
+				REQUIRE(shard.size() <= v.size() / count + 1);
+				all = join(all, values(shard));
+			}
+			REQUIRE(all == v);
+		}
+
+		for (int c : { -10, -2, 6 })
+		for (int d : { -11, 3, 14 })
+		for (int t : { -6, -1, 3, 4 })
+		{
+			auto other = values(loop::range(c, d, t));
+			auto in_other = [&](long long x) { return std::find(other.begin(), other.end(), x) != other.end(); };
+			Vec common, rest;
+			for (auto x : v) (in_other(x) ? common : rest).push_back(x);
+
+			INFO("range(" << c << ", " << d << ", " << t << ")");
+			REQUIRE(values(r.intersection(loop::range(c, d, t))) == common);
+
+			auto difference = r.difference(loop::range(c, d, t));
+			Vec parts = values(difference.first);
+			for (std::size_t k = 0; k < difference.gaps(); ++k) parts = join(parts, values(difference.gap(k)));
+			REQUIRE(join(parts, values(difference.second)) == rest);
+			REQUIRE(difference.size() == rest.size());
+		}
+	}
+
+	SECTION("unsigned ranges, descending by a signed step") 
+	{
+		auto r = loop::range(40u, 0u, -3);
+		REQUIRE(values(r.intersection(loop::range(0u, 50u, 4u))) == Vec({ 40, 28, 16, 4 }));
+		REQUIRE(values(loop::range(0u, 50u, 4u).intersection(r)) == Vec({ 4, 16, 28, 40 }));
+		REQUIRE(values(r.reverse()) == Vec({ 1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 34, 37, 40 }));
+		REQUIRE(values(loop::range(3u, 10u).reverse()) == Vec({ 9, 8, 7, 6, 5, 4, 3 }));
+		REQUIRE(values(loop::countdown(3u).reverse()) == Vec({ 0, 1, 2 }));
+
+		auto parts = r.difference(loop::range(10u, 30u));
+		REQUIRE(values(parts.first) == Vec({ 40, 37, 34, 31 }));
+		REQUIRE(values(parts.second) == Vec({ 7, 4, 1 }));
+		REQUIRE(parts.gaps() == 0u);
+
+		// other steps leave gaps between the common values
+		auto gaps = loop::range(0, 10).difference(loop::range(0, 10, 3));
+		REQUIRE(gaps.first.empty());
+		REQUIRE(gaps.second.empty());
+		REQUIRE(gaps.gaps() == 3u);
+		REQUIRE(values(gaps.gap(0)) == Vec({ 1, 2 }));
+		REQUIRE(values(gaps.gap(1)) == Vec({ 4, 5 }));
+		REQUIRE(values(gaps.gap(2)) == Vec({ 7, 8 }));
+		REQUIRE(gaps.size() == 6u);
+	}
+
+	SECTION("limits of the domain") 
+	{
+		const auto max = std::numeric_limits<std::uint64_t>::max();
+		auto all = loop::range(std::uint64_t(0), max, std::uint64_t(1), true);
+		REQUIRE(all.shard(1, 2).front() == std::uint64_t(1) << 63);
+		REQUIRE(all.shard(1, 2).back() == max);
+		REQUIRE(all.reverse().front() == max);
+		REQUIRE(all.intersection(loop::range(std::uint64_t(0), max, std::uint64_t(6), true)).size() == max / 6 + 1);
+
+		const int imin = std::numeric_limits<int>::min(), imax = std::numeric_limits<int>::max();
+		REQUIRE(values(loop::range(imin, imin + 3).reverse()) == Vec({ imin + 2, imin + 1, imin }));
+		REQUIRE(values(loop::range(imax - 9, imax, 3, true).drop(2)) == Vec({ imax - 3, imax }));
+
+		// the lcm 3*7 and the first common value 12 from the congruences
+		auto common = loop::range(0ll, 1ll << 62, 3).intersection(loop::range(5ll, 1ll << 61, 7));
+		REQUIRE(common.front() == 12);
+		REQUIRE(common[1] == 33);
+		REQUIRE(common.back() <= (1ll << 61));
+
+		// no common value: x = 1 mod 4 and x = 0 mod 2
+		REQUIRE(loop::range(1, 100, 4).intersection(loop::range(0, 100, 2)).empty());
+	}
+
+	SECTION("steps of half the domain and more")
+	{
+		auto r = loop::range(0u, 4000000000u, 3000000000u, true);
+		REQUIRE(values(r.intersection(r)) == Vec({ 0, 3000000000 }));
+		REQUIRE(values(r.reverse()) == Vec({ 3000000000, 0 }));
+		REQUIRE(r.difference(r).size() == 0u);
+		REQUIRE(r.difference(r).second.empty());
+
+		const int imin = std::numeric_limits<int>::min();
+		REQUIRE(values(loop::range(0, imin, imin, true).reverse()) == Vec({ imin, 0 }));
+		REQUIRE(values(loop::range(0, imin, imin, true).reverse().reverse()) == Vec({ 0, imin }));
+	}
+
+	constexpr auto twelve = loop::range(0, 100, 6).intersection(loop::range(0, 100, 4));
+	static_assert(twelve.size() == 9 && twelve[1] == 12, "");
+}
+
+// all 8 bit ranges from a few bounds by steps up to the full domain, 
+// against every other
+template <typename T, typename Step>
+void check_byte_algebra(std::vector<int> bounds, std::vector<Step> steps)
+{
+	using Vec = std::vector<int>;
+	auto values = [](auto r) { return Vec(r.begin(), r.end()); };
+
+	std::vector<decltype(loop::range(T(0), T(0), Step(1), true))> ranges;
+	for (int a : bounds)
+	for (int b : bounds)
+	for (Step s : steps)
+	for (bool with_end : { false, true })
+	{
+		ranges.push_back(loop::range(T(a), T(b), s, with_end));
+	}
+
+	for (auto& r : ranges)
+	{
+		auto v = values(r);
+		INFO("range(" << int(r.front()) << ", ..., " << int(r.back()) << "), " << v.size() << " values");
+		REQUIRE(values(r.reverse()) == Vec(v.rbegin(), v.rend()));
+
+		for (auto& o : ranges)
+		{
+			bool in_other[256] = {};
+			for (T x : o) in_other[std::uint8_t(x)] = true;
+			Vec common, rest;
+			for (int x : v) (in_other[std::uint8_t(x)] ? common : rest).push_back(x);
+
+			INFO("other range(" << int(o.front()) << ", ..., " << int(o.back()) << ")");
+			REQUIRE(values(r.intersection(o)) == common);
+
+			auto difference = r.difference(o);
+			Vec parts = values(difference.first);
+			for (std::size_t k = 0; k < difference.gaps(); ++k)
+			{
+				auto gap = values(difference.gap(k));
+				parts.insert(parts.end(), gap.begin(), gap.end());
+			}
+			auto second = values(difference.second);
+			parts.insert(parts.end(), second.begin(), second.end());
+			REQUIRE(parts == rest);
+		}
+	}
+}
+
+TEST_CASE("range algebra of all 8 bit steps", "[rangealgebra]")
+{
+	check_byte_algebra<std::int8_t, std::int8_t>({ -128, -1, 0, 100, 127 }, { -128, -127, -3, 1, 2, 127 });
+	check_byte_algebra<std::uint8_t, std::uint8_t>({ 0, 1, 127, 200, 255 }, { 1, 3, 127, 128, 200, 255 });
+}
+
+#ifdef __SIZEOF_INT128__
+// Catch cannot print __int128: comparisons in extra parentheses
+TEST_CASE("__int128 ranges", "[intrange]")
+{
+	__extension__ typedef __int128 int128;
+	__extension__ typedef unsigned __int128 uint128;
+	const auto q = int128(1) << 126;
+	std::vector<int128> v;
+
+	SECTION("range(int128(5))") 
+	{
+		for (auto i : loop::range(int128(5))) v.push_back(i);
+		REQUIRE((v == std::vector<int128>({ 0, 1, 2, 3, 4 })));
+	}
+
+	SECTION("full domain, step 2^126") 
+	{
+		const int128 min = -q - q, max = q - 1 + q;
+		for (auto i : loop::range(min, max, q, true)) v.push_back(i);
+		REQUIRE((v == std::vector<int128>({ min, -q, 0, q })));
+
+		std::vector<uint128> u;
+		for (auto i : loop::range(uint128(0), ~uint128(0), uint128(q), true)) u.push_back(i);
+		REQUIRE(u.size() == 4u);
+		REQUIRE((u[3] == 3*uint128(q)));
+	}
+}
+#endif
+
+TEST_CASE("static_range unrolled at compile time", "[intrange]")
+{
+	using Vec = std::vector<int>;
+	Vec v;
+	auto push = [&](auto i) { v.push_back(i); };
+
+	SECTION("static_range<4>()") 
+	{
+		loop::static_range<4>()(push);
+		REQUIRE(v == Vec({ 0, 1, 2, 3 }));
+		static_assert(loop::static_range<4>().size() == 4, "");
+	}
+
+	SECTION("static_range<0, 10, 4>() and with end") 
+	{
+		loop::static_range<0, 10, 4>()(push);
+		REQUIRE(v == Vec({ 0, 4, 8 }));
+
+		v.clear();
+		loop::static_range<0, 8, 4, true>()(push);
+		REQUIRE(v == Vec({ 0, 4, 8 }));
+	}
+
+	SECTION("negative step") 
+	{
+		loop::static_range<5, 0, -2>()(push);
+		REQUIRE(v == Vec({ 5, 3, 1 }));
+
+		v.clear();
+		loop::static_range<4, 0, -2, true>()(push);
+		REQUIRE(v == Vec({ 4, 2, 0 }));
+	}
+
+	SECTION("empty like range()") 
+	{
+		loop::static_range<0>()(push);
+		loop::static_range<5, 0>()(push);
+		loop::static_range<0, 5, 0>()(push);
+		REQUIRE(v == Vec{});
+		static_assert(loop::static_range<1, 1, 0, true>().size() == 1, "");
+	}
+
+	SECTION("values are template arguments") 
+	{
+		auto t = std::make_tuple(1, 2.5, 4);
+		double sum = 0;
+		loop::static_range<3>()([&](auto i) { sum += std::get<i>(t); });
+		REQUIRE(sum == 7.5);
+
+		loop::static_range<2, -1, -1>()([&](auto i) 
+			{ 
+				static_assert(decltype(i)::value >= 0 && decltype(i)::value <= 2, "");
+				v.push_back(std::get<i>(std::make_tuple(10, 11, 12))); 
+			});
+		REQUIRE(v == Vec({ 12, 11, 10 }));
+	}
+}
+
+TEST_CASE("range tables at compile time", "[intrange]")
+{
+	constexpr auto even = loop::to_array<4>(loop::range(0, 8, 2));
+	static_assert(even[0] == 0 && even[3] == 6, "");
+
+	constexpr auto down = loop::to_array<3>(loop::countdown(3u));
+	static_assert(down[0] == 2 && down[2] == 0, "");
+
+	constexpr auto odd = loop::to_array<3>(loop::generate(1, 3, loop::step<2>()));
+	static_assert(odd[2] == 5, "");
+
+	constexpr auto full = loop::to_array<4>(loop::range((signed char)-128, (signed char)127, (signed char)64, true));
+	static_assert(full[0] == -128 && full[3] == 64, "");
+
+	REQUIRE(even[1] == 2);
+	REQUIRE_THROWS_AS(loop::to_array<3>(loop::range(4)), std::length_error);
+	REQUIRE_THROWS_AS(loop::to_array<5>(loop::range(4)), std::length_error);
+}
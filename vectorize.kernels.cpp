@@ -0,0 +1,275 @@
+// Loops compiled with vectorization reports (-fopt-info-vec-optimized or
+// -Rpass=loop-vectorize) by CMake and checked by vectorize.test.cpp.
+// Each loop line carries a marker "vec: <pair> <range|hand>"; a range loop
+// must be vectorized whenever the handwritten loop of the same pair is.
+// The domain types cover signed and unsigned, 32 and 64 bit iteration variables;
+// countdown() counts unsigned in 64 bit.
+
+#include <cstddef>
+#include "loop.h"
+
+extern "C" {
+// ---[ int ]---
+
+int range_sum_int(int n)
+{
+	int s = 0;
+	for (auto i : loop::range(n)) s += i; // vec: sum_int range
+	return s;
+}
+
+int hand_sum_int(int n)
+{
+	int s = 0;
+	for (int i = 0; i < n; ++i) s += i; // vec: sum_int hand
+	return s;
+}
+
+void range_store_int(int* p, int n)
+{
+	for (auto i : loop::range(n)) p[i] = int(i); // vec: store_int range
+}
+
+void hand_store_int(int* p, int n)
+{
+	for (int i = 0; i < n; ++i) p[i] = int(i); // vec: store_int hand
+}
+
+void range_transform_int(float* q, const float* p, int n)
+{
+	for (auto i : loop::range(n)) q[i] = 2 * p[i] + 1; // vec: transform_int range
+}
+
+void hand_transform_int(float* q, const float* p, int n)
+{
+	for (int i = 0; i < n; ++i) q[i] = 2 * p[i] + 1; // vec: transform_int hand
+}
+
+void range_step_int(int* p, int n)
+{
+	for (auto i : loop::range(int(0), n, 3)) p[i] = int(i); // vec: step_int range
+}
+
+void hand_step_int(int* p, int n)
+{
+	for (int i = 0; i < n; i += 3) p[i] = int(i); // vec: step_int hand
+}
+
+void range_countdown_int(int* p, int n)
+{
+	for (auto i : loop::countdown(n)) p[i] = int(i); // vec: countdown_int range
+}
+
+void hand_countdown_int(int* p, int n)
+{
+	for (int i = n; i-- > 0; ) p[i] = int(i); // vec: countdown_int hand
+}
+
+// ---[ unsigned ]---
+
+unsigned range_sum_unsigned(unsigned n)
+{
+	unsigned s = 0;
+	for (auto i : loop::range(n)) s += i; // vec: sum_unsigned range
+	return s;
+}
+
+unsigned hand_sum_unsigned(unsigned n)
+{
+	unsigned s = 0;
+	for (unsigned i = 0; i < n; ++i) s += i; // vec: sum_unsigned hand
+	return s;
+}
+
+void range_store_unsigned(int* p, unsigned n)
+{
+	for (auto i : loop::range(n)) p[i] = int(i); // vec: store_unsigned range
+}
+
+void hand_store_unsigned(int* p, unsigned n)
+{
+	for (unsigned i = 0; i < n; ++i) p[i] = int(i); // vec: store_unsigned hand
+}
+
+void range_transform_unsigned(float* q, const float* p, unsigned n)
+{
+	for (auto i : loop::range(n)) q[i] = 2 * p[i] + 1; // vec: transform_unsigned range
+}
+
+void hand_transform_unsigned(float* q, const float* p, unsigned n)
+{
+	for (unsigned i = 0; i < n; ++i) q[i] = 2 * p[i] + 1; // vec: transform_unsigned hand
+}
+
+void range_step_unsigned(int* p, unsigned n)
+{
+	for (auto i : loop::range(unsigned(0), n, 3)) p[i] = int(i); // vec: step_unsigned range
+}
+
+void hand_step_unsigned(int* p, unsigned n)
+{
+	for (unsigned i = 0; i < n; i += 3) p[i] = int(i); // vec: step_unsigned hand
+}
+
+void range_countdown_unsigned(int* p, unsigned n)
+{
+	for (auto i : loop::countdown(n)) p[i] = int(i); // vec: countdown_unsigned range
+}
+
+void hand_countdown_unsigned(int* p, unsigned n)
+{
+	for (unsigned i = n; i-- > 0; ) p[i] = int(i); // vec: countdown_unsigned hand
+}
+
+// ---[ long long ]---
+
+long long range_sum_llong(long long n)
+{
+	long long s = 0;
+	for (auto i : loop::range(n)) s += i; // vec: sum_llong range
+	return s;
+}
+
+long long hand_sum_llong(long long n)
+{
+	long long s = 0;
+	for (long long i = 0; i < n; ++i) s += i; // vec: sum_llong hand
+	return s;
+}
+
+void range_store_llong(int* p, long long n)
+{
+	for (auto i : loop::range(n)) p[i] = int(i); // vec: store_llong range
+}
+
+void hand_store_llong(int* p, long long n)
+{
+	for (long long i = 0; i < n; ++i) p[i] = int(i); // vec: store_llong hand
+}
+
+void range_transform_llong(float* q, const float* p, long long n)
+{
+	for (auto i : loop::range(n)) q[i] = 2 * p[i] + 1; // vec: transform_llong range
+}
+
+void hand_transform_llong(float* q, const float* p, long long n)
+{
+	for (long long i = 0; i < n; ++i) q[i] = 2 * p[i] + 1; // vec: transform_llong hand
+}
+
+void range_step_llong(int* p, long long n)
+{
+	for (auto i : loop::range(0LL, n, 3)) p[i] = int(i); // vec: step_llong range
+}
+
+void hand_step_llong(int* p, long long n)
+{
+	for (long long i = 0; i < n; i += 3) p[i] = int(i); // vec: step_llong hand
+}
+
+void range_countdown_llong(int* p, long long n)
+{
+	for (auto i : loop::countdown(n)) p[i] = int(i); // vec: countdown_llong range
+}
+
+void hand_countdown_llong(int* p, long long n)
+{
+	for (long long i = n; i-- > 0; ) p[i] = int(i); // vec: countdown_llong hand
+}
+
+// ---[ std::size_t ]---
+
+std::size_t range_sum_size(std::size_t n)
+{
+	std::size_t s = 0;
+	for (auto i : loop::range(n)) s += i; // vec: sum_size range
+	return s;
+}
+
+std::size_t hand_sum_size(std::size_t n)
+{
+	std::size_t s = 0;
+	for (std::size_t i = 0; i < n; ++i) s += i; // vec: sum_size hand
+	return s;
+}
+
+void range_store_size(int* p, std::size_t n)
+{
+	for (auto i : loop::range(n)) p[i] = int(i); // vec: store_size range
+}
+
+void hand_store_size(int* p, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i) p[i] = int(i); // vec: store_size hand
+}
+
+void range_transform_size(float* q, const float* p, std::size_t n)
+{
+	for (auto i : loop::range(n)) q[i] = 2 * p[i] + 1; // vec: transform_size range
+}
+
+void hand_transform_size(float* q, const float* p, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i) q[i] = 2 * p[i] + 1; // vec: transform_size hand
+}
+
+void range_step_size(int* p, std::size_t n)
+{
+	for (auto i : loop::range(std::size_t{0}, n, 3)) p[i] = int(i); // vec: step_size range
+}
+
+void hand_step_size(int* p, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; i += 3) p[i] = int(i); // vec: step_size hand
+}
+
+void range_countdown_size(int* p, std::size_t n)
+{
+	for (auto i : loop::countdown(n)) p[i] = int(i); // vec: countdown_size range
+}
+
+void hand_countdown_size(int* p, std::size_t n)
+{
+	for (std::size_t i = n; i-- > 0; ) p[i] = int(i); // vec: countdown_size hand
+}
+
+// ---[ linspace ]---
+
+double range_linspace_sum(double a, double b, int n)
+{
+	double s = 0;
+	for (auto x : loop::linspace(a, b, n)) s += x; // vec: linspace_sum range
+	return s;
+}
+
+double hand_linspace_sum(double a, double b, int n)
+{
+	double s = 0;
+	auto dx = (b - a) * (1 / double(n));
+	for (int i = 0; i <= n; ++i) s += a + i * dx; // vec: linspace_sum hand
+	return s;
+}
+
+void range_linspace_store(double* p, double a, double b, int n)
+{
+	for (auto x : loop::linspace(a, b, n)) *p++ = x; // vec: linspace_store range
+}
+
+void hand_linspace_store(double* p, double a, double b, int n)
+{
+	auto dx = (b - a) * (1 / double(n));
+	for (int i = 0; i <= n; ++i) p[i] = a + i * dx; // vec: linspace_store hand
+}
+
+void range_linspace_float(float* p, float a, float b, std::size_t n)
+{
+	for (auto x : loop::linspace(a, b, n)) *p++ = x; // vec: linspace_float range
+}
+
+void hand_linspace_float(float* p, float a, float b, std::size_t n)
+{
+	auto dx = (b - a) * (1 / float(n));
+	for (std::size_t i = 0; i <= n; ++i) p[i] = a + i * dx; // vec: linspace_float hand
+}
+
+} // extern "C"
@@ -0,0 +1,142 @@
+// Checks the vectorization report of the compiler for the loops in vectorize.kernels.cpp:
+// a loop over a range must be vectorized whenever its handwritten counterpart is.
+// LOOP_VECTORIZE_SOURCE names the kernel source, LOOP_VECTORIZE_REPORT the
+// report written by CMake (GCC -fopt-info-vec-optimized or Clang -Rpass=loop-vectorize).
+
+#include <map>
+#include <set>
+#include <regex>
+#include <string>
+#include <fstream>
+#include "catch.hpp"
+
+namespace {
+
+struct Pair
+{
+	int range = 0, hand = 0; // source lines of the loops
+};
+
+// pair name -> source lines, from the markers "// vec: <pair> <range|hand>"
+std::map<std::string, Pair> markers(const char* filename)
+{
+	static const std::regex marker("// vec: (\\w+) (range|hand)");
+	std::map<std::string, Pair> pairs;
+	std::ifstream is(filename);
+	std::string line;
+	std::smatch m;
+
+	for (int number = 1; std::getline(is, line); ++number)
+	{
+		if (!std::regex_search(line, m, marker)) continue;
+		auto& pair = pairs[m[1]];
+		(m[2] == "range" ? pair.range : pair.hand) = number;
+	}
+	return pairs;
+}
+
+// source lines of the vectorized loops
+std::set<int> vectorized_lines(const char* filename)
+{
+	// GCC: "vectorize.kernels.cpp:16:34: optimized: loop vectorized using 16 byte vectors"
+	// Clang: "vectorize.kernels.cpp:16:3: remark: vectorized loop (vectorization width: 4, ...)"
+	static const std::regex report("vectorize\\.kernels\\.cpp:(\\d+):\\d+: .*(loop vectorized|vectorized loop)");
+	std::set<int> lines;
+	std::ifstream is(filename);
+	std::string line;
+	std::smatch m;
+
+	while (std::getline(is, line))
+	{
+		if (std::regex_search(line, m, report)) lines.insert(std::stoi(m[1]));
+	}
+	return lines;
+}
+
+const std::map<std::string, Pair>& pairs()
+{
+	static auto all = markers(LOOP_VECTORIZE_SOURCE);
+	return all;
+}
+
+const std::set<int>& vectorized()
+{
+	static auto all = vectorized_lines(LOOP_VECTORIZE_REPORT);
+	return all;
+}
+
+void require_vectorized_like_hand(const std::string& name)
+{
+	auto pair = pairs().find(name);
+	REQUIRE(pair != pairs().end());
+
+	bool range = vectorized().count(pair->second.range) > 0;
+	bool hand = vectorized().count(pair->second.hand) > 0;
+
+	INFO(name << ": range loop (line " << pair->second.range << ") "
+		<< (range ? "vectorized" : "scalar") << ", handwritten loop (line "
+		<< pair->second.hand << ") " << (hand ? "vectorized" : "scalar"));
+	if (hand) REQUIRE(range);
+}
+
+} // end namespace
+
+TEST_CASE("vectorize: kernels and report available", "[vectorize]")
+{
+	REQUIRE(!pairs().empty());
+	for (auto& pair : pairs())
+	{
+		INFO(pair.first);
+		CHECK(pair.second.range > 0);
+		CHECK(pair.second.hand > 0);
+	}
+	// at least the handwritten int loops are vectorized
+	REQUIRE(!vectorized().empty());
+}
+
+TEST_CASE("vectorize: range(n) int", "[vectorize]")
+{
+	require_vectorized_like_hand("sum_int");
+	require_vectorized_like_hand("store_int");
+	require_vectorized_like_hand("transform_int");
+	require_vectorized_like_hand("step_int");
+	require_vectorized_like_hand("countdown_int");
+}
+
+TEST_CASE("vectorize: range(n) unsigned reductions", "[vectorize]")
+{
+	require_vectorized_like_hand("sum_unsigned");
+	require_vectorized_like_hand("step_unsigned");
+	require_vectorized_like_hand("countdown_unsigned");
+}
+
+TEST_CASE("vectorize: range(n) unsigned indices", "[vectorize]")
+{
+	require_vectorized_like_hand("store_unsigned");
+	require_vectorized_like_hand("transform_unsigned");
+}
+
+TEST_CASE("vectorize: range(n) long long", "[vectorize]")
+{
+	require_vectorized_like_hand("sum_llong");
+	require_vectorized_like_hand("store_llong");
+	require_vectorized_like_hand("transform_llong");
+	require_vectorized_like_hand("step_llong");
+	require_vectorized_like_hand("countdown_llong");
+}
+
+TEST_CASE("vectorize: range(n) size_t", "[vectorize]")
+{
+	require_vectorized_like_hand("sum_size");
+	require_vectorized_like_hand("store_size");
+	require_vectorized_like_hand("transform_size");
+	require_vectorized_like_hand("step_size");
+	require_vectorized_like_hand("countdown_size");
+}
+
+TEST_CASE("vectorize: linspace(a, b, n)", "[vectorize]")
+{
+	require_vectorized_like_hand("linspace_sum");
+	require_vectorized_like_hand("linspace_store");
+	require_vectorized_like_hand("linspace_float");
+}